@@ -0,0 +1,128 @@
+#include <iostream>
+#include <iomanip>
+#include "Benchmark.h"
+
+/**
+ * @brief Starts (or restarts after a pause) measuring time
+ */
+void BenchTimer::resume() {
+    if (!running) {
+        start = clock::now();
+        running = true;
+    }
+}
+
+/**
+ * @brief Stops measuring time, the time elapsed until now is accumulated
+ */
+void BenchTimer::pause() {
+    if (running) {
+        elapsed += clock::now() - start;
+        running = false;
+    }
+}
+
+/**
+ * @brief Discards the time measured so far
+ */
+void BenchTimer::reset() {
+    elapsed = clock::duration(0);
+    running = false;
+}
+
+/**
+ * @brief Gets the time measured so far
+ * @return seconds measured
+ */
+double BenchTimer::seconds() const {
+    clock::duration total = elapsed;
+    if (running)
+        total += clock::now() - start;
+    return std::chrono::duration<double>(total).count();
+}
+
+/**
+ * @brief Constructor of the Benchmark harness
+ * @param dataset name of the dataset the cases are running on
+ * @param minSeconds minimum measured time of each case
+ * @param maxIterations maximum number of iterations of each case
+ * @param filter only cases whose name contains filter are run (empty runs every case)
+ */
+Benchmark::Benchmark(std::string dataset, double minSeconds, long maxIterations, std::string filter)
+        : dataset(std::move(dataset)), minSeconds(minSeconds), maxIterations(maxIterations), filter(std::move(filter)) {}
+
+/**
+ * @brief Sets the name of the dataset the following cases run on
+ * @param dataset
+ */
+void Benchmark::setDataset(std::string dataset) {
+    this->dataset = std::move(dataset);
+}
+
+/**
+ * @brief Runs a benchmark case, doubling the number of iterations until the measured time reaches minSeconds
+ * @param name name of the case
+ * @param body one iteration of the case, the timer is already running when it is called
+ */
+void Benchmark::run(const std::string &name, const std::function<void(BenchTimer&)> &body) {
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+        return;
+    BenchTimer timer;
+    long iterations = 1;
+    long total = 0;
+    while (true) {
+        for (long i = 0; i < iterations; i++) {
+            timer.resume();
+            body(timer);
+            timer.pause();
+        }
+        total += iterations;
+        if (timer.seconds() >= minSeconds || total >= maxIterations)
+            break;
+        iterations = std::min(iterations * 2, maxIterations - total);
+    }
+    results.push_back({dataset, name, total, timer.seconds() * 1e9 / total});
+    printResult(results.back());
+}
+
+/**
+ * @brief Runs a benchmark case a single time, used for expensive cases such as loading the dataset
+ * @param name name of the case
+ * @param body the case, the timer is already running when it is called
+ */
+void Benchmark::runOnce(const std::string &name, const std::function<void(BenchTimer&)> &body) {
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+        return;
+    BenchTimer timer;
+    timer.resume();
+    body(timer);
+    timer.pause();
+    results.push_back({dataset, name, 1, timer.seconds() * 1e9});
+    printResult(results.back());
+}
+
+/**
+ * @brief Gets the results of every case run so far
+ * @return results
+ */
+const std::vector<Benchmark::Result>& Benchmark::getResults() const {
+    return results;
+}
+
+/**
+ * @brief Prints the header of the results table
+ */
+void Benchmark::printHeader() {
+    std::cout << std::left << std::setw(12) << "dataset" << std::setw(40) << "case"
+              << std::right << std::setw(12) << "iterations" << std::setw(18) << "ns/op" << "\n";
+}
+
+/**
+ * @brief Prints a row of the results table
+ * @param result
+ */
+void Benchmark::printResult(const Result &result) {
+    std::cout << std::left << std::setw(12) << result.dataset << std::setw(40) << result.name
+              << std::right << std::setw(12) << result.iterations
+              << std::setw(18) << std::fixed << std::setprecision(1) << result.nsPerOp << std::endl;
+}
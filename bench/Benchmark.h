@@ -0,0 +1,59 @@
+#ifndef PROJETO_BENCHMARK_H
+#define PROJETO_BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+/**
+ * @brief Timer handed to the body of a benchmark, allows excluding setup/teardown work from the measurement
+ */
+class BenchTimer {
+private:
+    using clock = std::chrono::steady_clock;
+    clock::time_point start;
+    clock::duration elapsed{0};
+    bool running = false;
+
+public:
+    void resume();
+    void pause();
+    void reset();
+    double seconds() const;
+};
+
+/**
+ * @brief Benchmark is a small in-tree harness that runs each case until a minimum time is reached and reports ns/op
+ */
+class Benchmark {
+public:
+    /**
+     * @brief Result of a single benchmark case
+     */
+    struct Result {
+        std::string dataset;
+        std::string name;
+        long iterations;
+        double nsPerOp;
+    };
+
+private:
+    std::string dataset;
+    double minSeconds;
+    long maxIterations;
+    std::string filter;
+    std::vector<Result> results;
+
+public:
+    Benchmark(std::string dataset, double minSeconds, long maxIterations, std::string filter);
+    void setDataset(std::string dataset);
+    void run(const std::string &name, const std::function<void(BenchTimer&)> &body);
+    void runOnce(const std::string &name, const std::function<void(BenchTimer&)> &body);
+    const std::vector<Result>& getResults() const;
+    static void printHeader();
+    static void printResult(const Result &result);
+};
+
+
+#endif //PROJETO_BENCHMARK_H
@@ -0,0 +1,300 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <random>
+#include "Benchmark.h"
+#include "Course.h"
+#include "Auxiliar.h"
+
+/**
+ * @brief Splits a line of a csv file into its fields, ignoring the carriage return
+ * @param line
+ * @return fields
+ */
+static std::vector<std::string> splitCsvLine(std::string line) {
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+    std::vector<std::string> fields;
+    std::istringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+        fields.push_back(field);
+    return fields;
+}
+
+/**
+ * @brief Writes a copy of a data file repeated scale times, appending a suffix to the columns that must stay unique
+ * @param src path of the original file
+ * @param dst path of the scaled file
+ * @param scale number of copies
+ * @param suffixed indexes of the columns that receive the suffix
+ */
+static void writeScaledFile(const std::string &src, const std::string &dst, int scale, const std::vector<int> &suffixed) {
+    std::ifstream in(src);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line))
+        lines.push_back(line);
+
+    std::ofstream out(dst);
+    if (!lines.empty())
+        out << lines[0] << "\n";    // header
+    for (int k = 0; k < scale; k++) {
+        std::string suffix = k == 0 ? "" : "-" + std::to_string(k);
+        for (size_t i = 1; i < lines.size(); i++) {
+            std::vector<std::string> fields = splitCsvLine(lines[i]);
+            for (int column : suffixed) {
+                if (column < (int) fields.size())
+                    fields[column] += suffix;
+            }
+            for (size_t f = 0; f < fields.size(); f++)
+                out << (f ? "," : "") << fields[f];
+            out << "\r\n";
+        }
+    }
+}
+
+/**
+ * @brief Writes a synthetic dataset made of scale copies of the given dataset, each copy with its own UC's and students
+ * @param srcDir directory of the original data files
+ * @param dstDir directory where the scaled data files are written
+ * @param scale number of copies
+ */
+static void writeScaledDataset(const std::string &srcDir, const std::string &dstDir, int scale) {
+    std::filesystem::create_directories(dstDir);
+    writeScaledFile(srcDir + "classes_per_uc.csv", dstDir + "classes_per_uc.csv", scale, {0});
+    writeScaledFile(srcDir + "classes.csv", dstDir + "classes.csv", scale, {1});
+    writeScaledFile(srcDir + "students_classes.csv", dstDir + "students_classes.csv", scale, {0, 2});
+}
+
+/**
+ * @brief Loads a dataset into a Course, the same way the interactive program does
+ * @param course
+ * @param dataDir
+ */
+static void loadCourse(Course &course, const std::string &dataDir) {
+    Auxiliar::readClassesPerUc(course, dataDir);
+    Auxiliar::readStudentsClasses(course, dataDir);
+    Auxiliar::readClasses(course, dataDir);
+}
+
+/**
+ * @brief Enrollment of a student, used to pick and restore the arguments of the request benchmarks
+ */
+struct Enrollment {
+    Student *student;
+    std::string ucCode;
+    std::string classCode;
+    /**
+     * UC the student is not registered in, empty if none was sampled
+     */
+    std::string otherUcCode;
+};
+
+/**
+ * @brief Runs every query and request benchmark on a loaded Course
+ * @param bench
+ * @param course
+ */
+static void runCourseBenchmarks(Benchmark &bench, Course &course) {
+    std::mt19937 rng(42);
+    std::vector<Student*> students = course.getStudentsInCourse();
+    std::vector<Class> classes = course.getClasses();
+    std::vector<UC> ucs = course.getUCs();
+    std::vector<std::pair<std::string, int>> years = course.getYearOccupation();
+    if (students.empty() || classes.empty() || ucs.empty())
+        return;
+
+    // Sample of enrollments (student, UC, class) and of UC's each sampled student is not registered in
+    std::vector<Enrollment> enrollments;
+    for (int i = 0; i < 256; i++) {
+        Student *student = students[rng() % students.size()];
+        std::set<Class> studentClasses = course.getStudentClasses(student->getStudentCode());
+        if (studentClasses.empty())
+            continue;
+        auto class_ = studentClasses.begin();
+        std::advance(class_, rng() % studentClasses.size());
+        const UC &uc = ucs[rng() % ucs.size()];
+        bool enrolled = false;
+        for (const Class &c : studentClasses)
+            enrolled = enrolled || c.getUC() == uc.getUcCode();
+        enrollments.push_back({student, class_->getUC(), class_->getClassCode(), enrolled ? "" : uc.getUcCode()});
+    }
+    std::vector<Enrollment> notEnrolled;
+    for (const Enrollment &e : enrollments) {
+        if (!e.otherUcCode.empty())
+            notEnrolled.push_back(e);
+    }
+    if (enrollments.empty())
+        return;
+
+    size_t i = 0;
+    bench.run("findStudentByCode", [&](BenchTimer&) {
+        course.findStudentByCode(students[i++ % students.size()]->getStudentCode());
+    });
+    bench.run("getStudentsInCourse", [&](BenchTimer&) {
+        course.getStudentsInCourse();
+    });
+    bench.run("getStudentsInYear", [&](BenchTimer&) {
+        course.getStudentsInYear(years[i++ % years.size()].first);
+    });
+    bench.run("getStudentsInUC", [&](BenchTimer&) {
+        course.getStudentsInUC(ucs[i++ % ucs.size()].getUcCode());
+    });
+    bench.run("getStudentsInClass", [&](BenchTimer&) {
+        const Class &class_ = classes[i++ % classes.size()];
+        course.getStudentsInClass(class_.getClassCode(), class_.getUC());
+    });
+    bench.run("getStudentsInAtLeastUCs", [&](BenchTimer&) {
+        course.getStudentsInAtLeastUCs(1 + (int) (i++ % 7));
+    });
+    bench.run("getYearOccupation", [&](BenchTimer&) {
+        course.getYearOccupation();
+    });
+    bench.run("getSlotAvailability/UC", [&](BenchTimer&) {
+        course.getSlotAvailability(course.getStudentsInUC(ucs[i++ % ucs.size()].getUcCode()));
+    });
+    bench.run("getSlotAvailability/course", [&](BenchTimer&) {
+        course.getSlotAvailability(students);
+    });
+    bench.run("clone", [&](BenchTimer&) {
+        course.clone();
+    });
+    bench.run("checkScheduleConflicts", [&](BenchTimer&) {
+        const Enrollment &e = enrollments[i++ % enrollments.size()];
+        JoinRequest request(e.student->getStudentCode(), e.ucCode);
+        course.checkScheduleConflicts(e.student, classes[i % classes.size()], &request);
+    });
+
+    // Every request is undone (untimed) so that the Course stays the same between iterations, and the seats freed are
+    // taken so that they don't pile up as no Waitlist takes them here
+    if (!notEnrolled.empty()) {
+        bench.run("assessRequest/Join", [&](BenchTimer &timer) {
+            const Enrollment &e = notEnrolled[i++ % notEnrolled.size()];
+            JoinRequest request(e.student->getStudentCode(), e.otherUcCode);
+            bool accepted = course.assessRequest(&request);
+            timer.pause();
+            if (accepted) {
+                LeaveRequest undo(e.student->getStudentCode(), e.otherUcCode);
+                course.assessRequest(&undo);
+                course.takeFreedSeats();
+            }
+            timer.resume();
+        });
+    }
+    bench.run("assessRequest/Leave", [&](BenchTimer &timer) {
+        const Enrollment &e = enrollments[i++ % enrollments.size()];
+        LeaveRequest request(e.student->getStudentCode(), e.ucCode);
+        course.assessRequest(&request);
+        timer.pause();
+        course.addStudent(e.student->getStudentCode(), e.student->getName(), e.ucCode, e.classCode);
+        course.takeFreedSeats();
+        timer.resume();
+    });
+    if (!notEnrolled.empty()) {
+        bench.run("assessRequest/SwitchUc", [&](BenchTimer &timer) {
+            const Enrollment &e = notEnrolled[i++ % notEnrolled.size()];
+            SwitchUcRequest request(e.student->getStudentCode(), e.ucCode, e.otherUcCode);
+            bool accepted = course.assessRequest(&request);
+            timer.pause();
+            if (accepted) {
+                LeaveRequest undo(e.student->getStudentCode(), e.otherUcCode);
+                course.assessRequest(&undo);
+                course.addStudent(e.student->getStudentCode(), e.student->getName(), e.ucCode, e.classCode);
+            }
+            course.takeFreedSeats();
+            timer.resume();
+        });
+    }
+    bench.run("assessRequest/SwitchClass", [&](BenchTimer &timer) {
+        const Enrollment &e = enrollments[i++ % enrollments.size()];
+        std::vector<Class> ucClasses = course.getClassesInUC(e.ucCode);
+        const Class &next = ucClasses[i % ucClasses.size()];
+        SwitchClassRequest request(e.student->getStudentCode(), e.ucCode, e.classCode, next.getClassCode());
+        bool accepted = course.assessRequest(&request);
+        timer.pause();
+        if (accepted) {
+            LeaveRequest undo(e.student->getStudentCode(), e.ucCode);
+            course.assessRequest(&undo);
+            course.addStudent(e.student->getStudentCode(), e.student->getName(), e.ucCode, e.classCode);
+        }
+        course.takeFreedSeats();
+        timer.resume();
+    });
+}
+
+/**
+ * @brief Prints how to use the benchmark
+ */
+static void printUsage() {
+    std::cout << "Usage: projeto_bench [--data DIR] [--scales 1,10,100] [--work DIR] [--min-time SECONDS]"
+                 " [--max-iterations N] [--filter NAME]\n"
+                 "  --data      directory with the csv files (default ../), e.g. the output of projeto_datagen\n"
+                 "  --scales    datasets to run on, scale 1 is the original, scale k has k copies of it (default 1,10)\n"
+                 "  --work      directory where the scaled datasets are written (default bench_data/)\n"
+                 "  --min-time  minimum measured time of each case (default 0.2)\n"
+                 "  --max-iterations  maximum iterations of each case (default 100000)\n"
+                 "  --filter    only run the cases whose name contains NAME\n";
+}
+
+int main(int argc, char *argv[]) {
+    std::string dataDir = "../";
+    std::string workDir = "bench_data/";
+    std::vector<int> scales = {1, 10};
+    double minSeconds = 0.2;
+    long maxIterations = 100000;
+    std::string filter;
+
+    for (int arg = 1; arg < argc; arg++) {
+        std::string option = argv[arg];
+        if (option == "--help" || arg + 1 >= argc) {
+            printUsage();
+            return option == "--help" ? 0 : 1;
+        }
+        std::string value = argv[++arg];
+        if (option == "--data")
+            dataDir = value.back() == '/' ? value : value + "/";
+        else if (option == "--work")
+            workDir = value.back() == '/' ? value : value + "/";
+        else if (option == "--scales") {
+            scales.clear();
+            std::istringstream ss(value);
+            std::string scale;
+            while (std::getline(ss, scale, ','))
+                scales.push_back(std::stoi(scale));
+        }
+        else if (option == "--min-time")
+            minSeconds = std::stod(value);
+        else if (option == "--max-iterations")
+            maxIterations = std::stol(value);
+        else if (option == "--filter")
+            filter = value;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Benchmark bench("", minSeconds, maxIterations, filter);
+    Benchmark::printHeader();
+    for (int scale : scales) {
+        std::string scaledDir = dataDir;
+        if (scale > 1) {
+            scaledDir = workDir + "x" + std::to_string(scale) + "/";
+            writeScaledDataset(dataDir, scaledDir, scale);
+        }
+        bench.setDataset("x" + std::to_string(scale));
+
+        Course course;
+        bool loaded = false;
+        bench.runOnce("load", [&](BenchTimer&) {
+            loadCourse(course, scaledDir);
+            loaded = true;
+        });
+        if (!loaded)
+            loadCourse(course, scaledDir);
+        runCourseBenchmarks(bench, course);
+    }
+    return 0;
+}
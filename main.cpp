@@ -1,16 +1,170 @@
-#include <iostream>
+#include <cstdlib>
 #include <fstream>
-#include <sstream>
-#include "src/Course.h"
-#include "src/Terminal.h"
-#include "src/Auxiliar.h"
+#include <iostream>
+#include <string>
+#include <utility>
+#include "Course.h"
+#include "Terminal.h"
+#include "BatchRunner.h"
+#include "Server.h"
+#include "ScheduleExporter.h"
+#include "HistoryCompactor.h"
+#include "DataWatcher.h"
+#include "Auxiliar.h"
+
+/**
+ * Usage: projeto                                       interactive interface
+ *        projeto --exec <file|-> [--format csv|jsonl]  runs the commands of a file (or of stdin), see BatchRunner
+ *        projeto --serve <socket> [--threads n]        serves the commands of many clients, see Server
+ *        projeto --export <dir> [--format text|csv|ics] [--threads n] [--term-start date] [--term-weeks n]
+ *                                                      writes the schedule of every student, see ScheduleExporter
+ *                                                      (and of the whole course in ics)
+ *        projeto --rebase [--all]                      writes the course with the requests done as the new data files
+ *                                                      and empties the request history, see BatchRunner::rebase
+ *        projeto --compact                             rewrites the request history with the fewest requests with the
+ *                                                      same effect, see HistoryCompactor
+ *        projeto --watch                               applies the rows changed in the data files to the course with the
+ *                                                      requests done, and reports the students with conflicts, see
+ *                                                      DataWatcher (the interactive interface does it too)
+ */
+int main(int argc, char *argv[]) {
+    std::string execPath, socketPath, exportPath, formatName, termStart;
+    bool rebase = false, rebaseAll = false, compact = false, watch = false;
+    size_t threads = std::thread::hardware_concurrency();
+    int termWeeks = IcsWriter::DEFAULT_WEEKS;
+    auto usage = [&argv]() {
+        std::cerr << "Usage: " << argv[0] << " [--exec <file|-> [--format csv|jsonl] | --serve <socket> [--threads n]"
+                  << " | --export <dir> [--format text|csv|ics] [--threads n] [--term-start yyyy-mm-dd] [--term-weeks n]"
+                  << " | --rebase [--all] | --compact | --watch]\n";
+        return 2;
+    };
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--exec" && i + 1 < argc)
+            execPath = argv[++i];
+        else if (arg == "--format" && i + 1 < argc)
+            formatName = argv[++i];
+        else if (arg == "--serve" && i + 1 < argc)
+            socketPath = argv[++i];
+        else if (arg == "--export" && i + 1 < argc)
+            exportPath = argv[++i];
+        else if (arg == "--rebase")
+            rebase = true;
+        else if (arg == "--compact")
+            compact = true;
+        else if (arg == "--watch")
+            watch = true;
+        else if (arg == "--all")
+            rebaseAll = true;
+        else if (arg == "--term-start" && i + 1 < argc)
+            termStart = argv[++i];
+        else if (arg == "--term-weeks" && i + 1 < argc && std::string(argv[i + 1]).find_first_not_of("0123456789") == std::string::npos
+                 && std::string(argv[i + 1]).size() <= 2 && std::atoi(argv[i + 1]) > 0)
+            termWeeks = std::atoi(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc && std::string(argv[i + 1]).find_first_not_of("0123456789") == std::string::npos
+                 && std::string(argv[i + 1]).size() <= 4 && std::atoi(argv[i + 1]) > 0)
+            threads = std::atoi(argv[++i]);
+        else
+            return usage();
+    }
+    BatchRunner::Format format = BatchRunner::CSV;
+    ScheduleExporter::Format exportFormat = ScheduleExporter::TEXT;
+    if (!formatName.empty() && !(exportPath.empty() ? BatchRunner::parseFormat(formatName, format)
+                                                    : ScheduleExporter::parseFormat(formatName, exportFormat)))
+        return usage();
+    if (rebaseAll && !rebase)
+        return usage();
+    IcsWriter::Term term = IcsWriter::currentTerm(termWeeks);
+    if (!termStart.empty() && !IcsWriter::parseTerm(termStart, termWeeks, term))
+        return usage();
 
-int main() {
-    Course leic = Course();
+    Course leic;
     Auxiliar::readClassesPerUc(leic);
     Auxiliar::readStudentsClasses(leic);
     Auxiliar::readClasses(leic);
-    Terminal terminal = Terminal(leic);
+    if (!socketPath.empty()) {
+        BatchRunner runner(std::move(leic), BatchRunner::JSONL);
+        Server server(runner, socketPath, threads);
+        return server.run();
+    }
+    if (!exportPath.empty()) {
+        // Exports the Course with the requests done so far
+        BatchRunner runner(std::move(leic));
+        runner.load();
+        ScheduleExporter exporter(runner.getCourse(), exportFormat, exportPath, threads);
+        exporter.setTerm(term);
+        ScheduleExporter::Report report = exporter.exportStudents();
+        ScheduleExporter::printReport(std::cout, report);
+        if (exportFormat == ScheduleExporter::ICS) {
+            ScheduleExporter::Report course = exporter.exportCourse();
+            std::cout << "Calendar of the course: ";
+            ScheduleExporter::printReport(std::cout, course);
+            report.failed += course.failed;
+        }
+        return report.failed == 0 ? 0 : 1;
+    }
+    if (compact) {
+        std::queue<Request*> pastRequests;
+        Auxiliar::loadRequestRecord(pastRequests);
+        std::vector<std::string> requests, compacted;
+        for (; !pastRequests.empty(); pastRequests.pop()) {
+            requests.push_back(Auxiliar::formatRequest(pastRequests.front()));
+            delete pastRequests.front();
+        }
+        HistoryCompactor::Report report = HistoryCompactor(leic).compact(requests, compacted);
+        HistoryCompactor::printReport(std::cout, report);
+        if (report.after < report.before && !Auxiliar::replaceRequestHistory(compacted)) {
+            std::cerr << "Can't write the request history, it was kept\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (rebase) {
+        BatchRunner runner(std::move(leic));
+        runner.load();
+        if (!runner.rebase(rebaseAll)) {
+            std::cerr << "Can't write the data files, the request history was kept\n";
+            return 1;
+        }
+        return 0;
+    }
+    if (!execPath.empty()) {
+        std::ifstream file;
+        if (execPath != "-") {
+            file.open(execPath);
+            if (!file) {
+                std::cerr << "Can't open " << execPath << "\n";
+                return 2;
+            }
+        }
+        BatchRunner runner(std::move(leic), format);
+        return runner.run(execPath == "-" ? std::cin : file) == 0 ? 0 : 1;
+    }
+    if (watch) {
+        std::queue<Request*> pastRequests;
+        Auxiliar::loadRequestRecord(pastRequests);
+        std::vector<Request*> requests;
+        for (; !pastRequests.empty(); pastRequests.pop())
+            requests.push_back(pastRequests.front());
+        leic.replayRequests(requests);
+        leic.takeFreedSeats();
+        for (Request *request : requests)
+            delete request;
+        DataWatcher watcher(leic);
+        if (!watcher.isWatching()) {
+            std::cerr << "Can't watch the data files\n";
+            return 1;
+        }
+        std::cout << "Watching the data files, " << requests.size() << " requests redone" << std::endl;
+        DataWatcher::Report report;
+        while (true) {
+            if (watcher.poll(report, -1)) {
+                DataWatcher::printReport(std::cout, report);
+                std::cout.flush();
+            }
+        }
+    }
+    Terminal terminal(std::move(leic));
     terminal.run();
     return 0;
 }
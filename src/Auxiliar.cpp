@@ -1,14 +1,21 @@
+#include <cstdio>
 #include <sstream>
 #include <fstream>
+#include <iomanip>
+#include <fcntl.h>
+#include <unistd.h>
 #include "Auxiliar.h"
+#include "Metrics.h"
 
 /**
  * @brief Reads the UC's and its Classes
  * @param course
+ * @param dataDir directory containing the data files
  * @details Time Complexity O( n* m) n = number of lines m = number of  UC's
  */
-void Auxiliar::readClassesPerUc(Course& course){
-    std::ifstream file("../classes_per_uc.csv");
+void Auxiliar::readClassesPerUc(Course& course, const std::string &dataDir){
+    METRICS_TIMER(LOAD_CLASSES_PER_UC);
+    std::ifstream file(dataDir + "classes_per_uc.csv");
     std::string line;
     std::string ucCode, classCode;
 
@@ -26,10 +33,12 @@ void Auxiliar::readClassesPerUc(Course& course){
 /**
  * @brief Reads the Students and Classes they're registered in
  * @param course
+ * @param dataDir directory containing the data files
  * @details Time Complexity O(n * m) n = number of lines m = number of  UC's
  */
-void Auxiliar::readStudentsClasses(Course& course){
-    std::ifstream file("../students_classes.csv");
+void Auxiliar::readStudentsClasses(Course& course, const std::string &dataDir){
+    METRICS_TIMER(LOAD_STUDENTS_CLASSES);
+    std::ifstream file(dataDir + "students_classes.csv");
     std::string line;
     std::string studentCode, studentName, ucCode, classCode;
 
@@ -48,10 +57,12 @@ void Auxiliar::readStudentsClasses(Course& course){
 /**
  * @brief Reads the Lectures of the Course
  * @param course
+ * @param dataDir directory containing the data files
  * @details Time Complexity O(n * m) n = number of lines m = number of  UC's
  */
-void Auxiliar::readClasses(Course& course) {
-    std::ifstream file("../classes.csv");
+void Auxiliar::readClasses(Course& course, const std::string &dataDir) {
+    METRICS_TIMER(LOAD_CLASSES);
+    std::ifstream file(dataDir + "classes.csv");
     std::string line;
     std::string classCode, ucCode, type, weekday, startHour, duration;
     float startHourF, durationF;
@@ -72,85 +83,262 @@ void Auxiliar::readClasses(Course& course) {
     }
 }
 
+/**
+ * @brief Replaces a data file atomically: writes a temporary file next to it, flushes it to the disk and renames it over
+ * the file, so a reader sees either the old file or the whole new one
+ * @param path file replaced
+ * @param write writes the contents to the stream given
+ * @return false if the file couldn't be written, it is left as it was
+ */
+template <typename Writer>
+static bool replaceFile(const std::string &path, Writer write) {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        write(file);
+        file.flush();
+        if (!file) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    int fd = open(temporary.c_str(), O_RDONLY);
+    bool synced = fd >= 0 && fsync(fd) == 0;
+    if (fd >= 0)
+        close(fd);
+    if (!synced || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the UC's and their Classes, like readClassesPerUc reads them, in the order the Classes were added
+ * @param course
+ * @param dataDir directory containing the data files
+ * @return false if the file couldn't be written
+ * @details Time Complexity O(c) c = number of Classes
+ */
+bool Auxiliar::writeClassesPerUc(const Course& course, const std::string &dataDir) {
+    return replaceFile(dataDir + "classes_per_uc.csv", [&course](std::ostream &file) {
+        file << "UcCode,ClassCode\r\n";
+        for (const Class *class_ : course.getClassesByIndex())
+            file << class_->getUC() << ',' << class_->getClassCode() << "\r\n";
+    });
+}
+
+/**
+ * @brief Writes the Students and the Classes they're registered in, like readStudentsClasses reads them. Each row is
+ * written as it is read from the Course, the file is never built in memory.
+ * @param course
+ * @param dataDir directory containing the data files
+ * @return false if the file couldn't be written
+ * @details Time Complexity O(c + e + s) c = number of Classes, e = number of enrollments, s = number of Students
+ */
+bool Auxiliar::writeStudentsClasses(const Course& course, const std::string &dataDir) {
+    return replaceFile(dataDir + "students_classes.csv", [&course](std::ostream &file) {
+        file << "StudentCode,StudentName,UcCode,ClassCode\r\n";
+        for (const Class *class_ : course.getClassesByIndex()) {
+            for (const Student *student : class_->getStudents()) {
+                file << student->getStudentCode() << ',' << student->getName() << ','
+                     << class_->getUC() << ',' << class_->getClassCode() << "\r\n";
+            }
+        }
+        // Students that left every UC are kept with a row without UC, which readStudentsClasses reads as such
+        for (const Student *student : course.getStudentsInCourse()) {
+            if (student->getClassIndexes().empty())
+                file << student->getStudentCode() << ',' << student->getName() << ",,\r\n";
+        }
+    });
+}
+
+/**
+ * @brief Writes the Lectures of the Course, like readClasses reads them
+ * @param course
+ * @param dataDir directory containing the data files
+ * @return false if the file couldn't be written
+ * @details Time Complexity O(c + l) c = number of Classes, l = number of Lectures
+ */
+bool Auxiliar::writeClasses(const Course& course, const std::string &dataDir) {
+    return replaceFile(dataDir + "classes.csv", [&course](std::ostream &file) {
+        file << "ClassCode,UcCode,Weekday,StartHour,Duration,Type\r\n";
+        for (const Class *class_ : course.getClassesByIndex()) {
+            for (const Lecture &lecture : class_->getSchedule().getLectures()) {
+                file << lecture.getClass() << ',' << lecture.getUC() << ',' << Timeslots::getWeekdayName(lecture.getWeekday())
+                     << ',' << lecture.getStartHour() << ',' << lecture.getDuration() << ',' << lecture.getType() << "\r\n";
+            }
+        }
+    });
+}
+
 /**
  * @brief Loads the pastRequest into a queue by chronological order
  * @param pastRequests
+ * @param path file with one request per line, in the format of the request history
  * @details Time Complexity O(n) n = number of past requests
  */
-void Auxiliar::loadRequestRecord(std::queue<Request *> &pastRequests) {
-    std::ifstream file("../request_history.txt");
+void Auxiliar::loadRequestRecord(std::queue<Request *> &pastRequests, const std::string &path) {
+    METRICS_TIMER(LOAD_REQUESTS);
+    std::ifstream file(path);
     std::string line;
-    std::string reqType;
     while (std::getline(file, line)) {
-        std::istringstream ss(line);
-        getline(ss, reqType, ',');
-        if (reqType == "Join"){
-            std::string studentCode, ucCode;
-            getline(ss, studentCode, ',');
-            getline(ss, ucCode);
-            JoinRequest* newReq = new JoinRequest(studentCode, ucCode);
-            pastRequests.push(newReq);
-        }
-        else if (reqType == "Leave"){
-            std::string studentCode, ucCode;
-            getline(ss, studentCode, ',');
-            getline(ss, ucCode);
-            LeaveRequest* newReq = new LeaveRequest(studentCode, ucCode);
-            pastRequests.push(newReq);
-        }
-        else if (reqType == "SwitchUc"){
-            std::string studentCode, ucCodeCurrent, ucCodeNext;
-            getline(ss, studentCode, ',');
-            getline(ss, ucCodeCurrent, ',');
-            getline(ss, ucCodeNext);
-            SwitchUcRequest* newReq = new SwitchUcRequest(studentCode, ucCodeCurrent, ucCodeNext);
-            pastRequests.push(newReq);
-        }
-        else if (reqType == "SwitchClass"){
-            std::string studentCode, ucCode, classCodeCurrent, classCodeNext;
-            getline(ss, studentCode, ',');
-            getline(ss, ucCode, ',');
-            getline(ss, classCodeCurrent, ',');
-            getline(ss, classCodeNext);
-            SwitchClassRequest* newReq = new SwitchClassRequest(studentCode, ucCode, classCodeCurrent, classCodeNext);
-            pastRequests.push(newReq);
-        }
+        Request *request = parseRequest(line);
+        if (request != nullptr)
+            pastRequests.push(request);
     }
 }
 
+/**
+ * @brief Reads a request written in the format of the request history
+ * @param line e.g. "Join,202025232,L.EIC002" or, with the time it was done, "Join,202025232,L.EIC002,1LEIC05,@2023-10-19T14:30:00"
+ * @return new request, the caller takes ownership of it. nullptr if the line isn't a request.
+ */
+Request* Auxiliar::parseRequest(const std::string &line) {
+    // The time is the last field, missing in older histories
+    std::time_t time = 0;
+    size_t timeField = line.rfind(",@");
+    if (timeField != std::string::npos && !parseTime(line.substr(timeField + 2), time))
+        return nullptr;
+    std::istringstream ss(line.substr(0, timeField));
+    std::string reqType;
+    getline(ss, reqType, ',');
+    Request *request = nullptr;
+    if (reqType == "Join"){
+        std::string studentCode, ucCode, classCode;
+        getline(ss, studentCode, ',');
+        getline(ss, ucCode, ',');
+        getline(ss, classCode);         // Class joined, missing in older histories
+        request = new JoinRequest(studentCode, ucCode, classCode);
+    }
+    else if (reqType == "Leave"){
+        std::string studentCode, ucCode;
+        getline(ss, studentCode, ',');
+        getline(ss, ucCode);
+        request = new LeaveRequest(studentCode, ucCode);
+    }
+    else if (reqType == "SwitchUc"){
+        std::string studentCode, ucCodeCurrent, ucCodeNext;
+        getline(ss, studentCode, ',');
+        getline(ss, ucCodeCurrent, ',');
+        getline(ss, ucCodeNext);
+        request = new SwitchUcRequest(studentCode, ucCodeCurrent, ucCodeNext);
+    }
+    else if (reqType == "SwitchClass"){
+        std::string studentCode, ucCode, classCodeCurrent, classCodeNext;
+        getline(ss, studentCode, ',');
+        getline(ss, ucCode, ',');
+        getline(ss, classCodeCurrent, ',');
+        getline(ss, classCodeNext);
+        request = new SwitchClassRequest(studentCode, ucCode, classCodeCurrent, classCodeNext);
+    }
+    if (request != nullptr)
+        request->setTime(time);
+    return request;
+}
+
 /**
  * @brief Save the requests into a file
  * @param requestRecord
  * @details Time Complexity O(n) n = number of requests
  */
 void Auxiliar::saveRequestRecord(std::stack<Request *> requestRecord) {
+    std::vector<Request *> requests(requestRecord.size());
+    for (size_t i = requests.size(); i > 0; i--) {
+        requests[i - 1] = requestRecord.top();
+        requestRecord.pop();
+    }
+    saveRequests(requests, "../request_history.txt");
+}
+
+/**
+ * @brief Save requests into a file, one per line, in the format of the request history
+ * @param requests
+ * @param path
+ * @details Time Complexity O(n) n = number of requests
+ */
+void Auxiliar::saveRequests(const std::vector<Request *> &requests, const std::string &path) {
+    std::ofstream file(path);
+    for (Request *request : requests)
+        file << formatRequest(request) << "\n";
+}
+
+/**
+ * @brief Replaces the request history atomically, like the data files (see replaceFile)
+ * @param requests one per line, in the format of the request history
+ * @param path
+ * @return false if the history couldn't be written, it is left as it was
+ * @details Time Complexity O(n) n = number of requests
+ */
+bool Auxiliar::replaceRequestHistory(const std::vector<std::string> &requests, const std::string &path) {
+    return replaceFile(path, [&requests](std::ostream &file) {
+        for (const std::string &request : requests)
+            file << request << "\n";
+    });
+}
+
+/**
+ * @brief Writes a request in the format of the request history
+ * @param request
+ * @return line, without the line break
+ */
+std::string Auxiliar::formatRequest(const Request *request) {
     /*
-     JOIN        studentCode, ucCode
+     JOIN        studentCode, ucCode,        classCode (optional)
      LEAVE       studentCode, ucCode
      SWITCHUC    studentCode, ucCodeCurrent, ucCodeNext
      SWITCHCLASS studentCode, ucCode,        classCodeCurrent, classCodeNext
+     followed by @time, if it is known
      */
-    std::ofstream file("../request_history.txt");
-    std::stack<Request *> reversedRecord;
-    while (!requestRecord.empty()){
-        reversedRecord.push(requestRecord.top());
-        requestRecord.pop();
+    std::ostringstream line;
+    if (const JoinRequest* joinReq = dynamic_cast<const JoinRequest*>(request)) {
+        line << "Join," << joinReq->getStudentCode() << "," << joinReq->getUcCode();
+        if (!joinReq->getClassCode().empty())
+            line << "," << joinReq->getClassCode();
     }
+    else if (const LeaveRequest* leaveReq = dynamic_cast<const LeaveRequest*>(request)) {
+        line << "Leave," << leaveReq->getStudentCode() << "," << leaveReq->getUcCode();
+    }
+    else if (const SwitchUcRequest* switchUcReq = dynamic_cast<const SwitchUcRequest*>(request)) {
+        line << "SwitchUc," << switchUcReq->getStudentCode() << "," << switchUcReq->getUcCodeCurrent() << "," << switchUcReq->getUcCodeNext();
+    }
+    else if (const SwitchClassRequest* switchClassReq = dynamic_cast<const SwitchClassRequest*>(request)) {
+        line << "SwitchClass," << switchClassReq->getStudentCode() << "," << switchClassReq->getUcCode() << "," << switchClassReq->getClassCodeCurrent() << "," << switchClassReq->getClassCodeNext();
+    }
+    if (request->getTime() != 0)
+        line << ",@" << formatTime(request->getTime());
+    return line.str();
+}
 
-    while (!reversedRecord.empty()){
-        Request* request =  reversedRecord.top();
-        if (JoinRequest* joinReq = dynamic_cast<JoinRequest*>(request)) {
-            file << "Join," << joinReq->getStudentCode() << "," << joinReq->getUcCode() << "\n";
-        }
-        else if (LeaveRequest* leaveReq = dynamic_cast<LeaveRequest*>(request)) {
-            file << "Leave," << leaveReq->getStudentCode() << "," << leaveReq->getUcCode() << "\n";
-        }
-        else if (SwitchUcRequest* switchUcReq = dynamic_cast<SwitchUcRequest*>(request)) {
-            file << "SwitchUc," << switchUcReq->getStudentCode() << "," << switchUcReq->getUcCodeCurrent() << "," << switchUcReq->getUcCodeNext() << "\n";
-        }
-        else if (SwitchClassRequest* switchClassReq = dynamic_cast<SwitchClassRequest*>(request)) {
-            file<< "SwitchClass,"  << switchClassReq->getStudentCode() << "," << switchClassReq->getUcCode() << "," << switchClassReq->getClassCodeCurrent() << "," << switchClassReq->getClassCodeNext() << "\n";
-        }
-        reversedRecord.pop();
+/**
+ * @brief Writes a time in local time, like the request history
+ * @param time
+ * @return e.g. "2023-10-19T14:30:00"
+ */
+std::string Auxiliar::formatTime(std::time_t time) {
+    std::tm local{};
+    localtime_r(&time, &local);
+    std::ostringstream str;
+    str << std::put_time(&local, "%Y-%m-%dT%H:%M:%S");
+    return str.str();
+}
+
+/**
+ * @brief Reads a time in local time
+ * @param str date and time ("2023-10-19T14:30:00" or "2023-10-19T14:30") or only the date ("2023-10-19", at midnight)
+ * @param time set to the time read
+ * @return false if the string isn't a time
+ */
+bool Auxiliar::parseTime(const std::string &str, std::time_t &time) {
+    for (const char *format : {"%Y-%m-%dT%H:%M:%S", "%Y-%m-%dT%H:%M", "%Y-%m-%d"}) {
+        std::tm local{};
+        std::istringstream ss(str);
+        ss >> std::get_time(&local, format);
+        if (ss.fail() || ss.peek() != EOF)
+            continue;
+        local.tm_isdst = -1;
+        time = std::mktime(&local);
+        return time != -1;
     }
+    return false;
 }
@@ -8,17 +8,26 @@
 
 
 /**
- * @brief Auxiliar is used to read the data files and request history
+ * @brief Auxiliar is used to read (and write back) the data files and request history
  */
 
 class Auxiliar {
 public:
-    static void readClassesPerUc(Course& course);
-    static void readStudentsClasses(Course& course);
-    static void readClasses(Course& course);
-
-    static void loadRequestRecord(std::queue<Request*> &pastRequests);
+    static void readClassesPerUc(Course& course, const std::string &dataDir = "../");
+    static void readStudentsClasses(Course& course, const std::string &dataDir = "../");
+    static void readClasses(Course& course, const std::string &dataDir = "../");
+    static bool writeClassesPerUc(const Course& course, const std::string &dataDir = "../");
+    static bool writeStudentsClasses(const Course& course, const std::string &dataDir = "../");
+    static bool writeClasses(const Course& course, const std::string &dataDir = "../");
+
+    static void loadRequestRecord(std::queue<Request*> &pastRequests, const std::string &path = "../request_history.txt");
     static void saveRequestRecord(std::stack<Request*> requestRecord);
+    static void saveRequests(const std::vector<Request*> &requests, const std::string &path);
+    static bool replaceRequestHistory(const std::vector<std::string> &requests, const std::string &path = "../request_history.txt");
+    static Request* parseRequest(const std::string &line);
+    static std::string formatRequest(const Request *request);
+    static std::string formatTime(std::time_t time);
+    static bool parseTime(const std::string &str, std::time_t &time);
 };
 
 
@@ -0,0 +1,849 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <queue>
+#include <set>
+#include <sstream>
+#include "BatchRunner.h"
+#include "Auxiliar.h"
+#include "HistoryCompactor.h"
+#include "IcsWriter.h"
+#include "Metrics.h"
+
+/**
+ * @brief Constructor of the BatchRunner. Takes over the course, like the Terminal.
+ * @param course Course being managed
+ * @param format format of the results
+ * @param out stream the results are written to
+ */
+BatchRunner::BatchRunner(Course &&course, Format format, std::ostream &out) : course(std::move(course)), format(format), out(out) {}
+
+/**
+ * @brief Destructor of the BatchRunner. Frees the memory associated with the requests.
+ */
+BatchRunner::~BatchRunner() {
+    while (!requestRecord.empty()) {
+        delete requestRecord.top();
+        requestRecord.pop();
+    }
+}
+
+/**
+ * @brief Gets the format of the results from its name
+ * @param name "csv" or "jsonl"
+ * @param format set to the format named
+ * @return false if the name isn't a format
+ */
+bool BatchRunner::parseFormat(const std::string &name, Format &format) {
+    if (name == "csv")
+        format = CSV;
+    else if (name == "jsonl")
+        format = JSONL;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Loads the requests previously made and redoes them, runs every command and writes its result, and before
+ * returning saves the requests done and the waitlist.
+ * @param commands one command per line
+ * @return number of commands that failed (unknown, with wrong arguments or about something that doesn't exist)
+ * @details Time Complexity O(c * command) c = number of commands, no screen is printed and nothing waits for input
+ */
+int BatchRunner::run(std::istream &commands) {
+    load();
+    int failed = 0;
+    int lineNumber = 0;
+    std::string line;
+    while (std::getline(commands, line)) {
+        if (!runCommand(line, ++lineNumber, out))
+            failed++;
+    }
+    out.flush();
+    save();
+    return failed;
+}
+
+/**
+ * @brief Loads the requests previously made and redoes them, and loads the waitlist
+ */
+void BatchRunner::load() {
+    std::queue<Request*> pastRequests;
+    Auxiliar::loadRequestRecord(pastRequests);
+    std::vector<Request*> requests;
+    for (; !pastRequests.empty(); pastRequests.pop()) {
+        requests.push_back(pastRequests.front());
+        requestRecord.push(pastRequests.front());
+    }
+    history.replay(course, requests);
+    // The requests taken from the waitlist are already in the history, so the seats freed while redoing are not given again
+    course.takeFreedSeats();
+    std::queue<Request*> waiting;
+    Auxiliar::loadRequestRecord(waiting, "../waitlist.txt");
+    for (; !waiting.empty(); waiting.pop()) {
+        if (waitlist.add(waiting.front()) == 0)
+            delete waiting.front();
+    }
+}
+
+/**
+ * @brief Saves the requests done and the waitlist
+ */
+void BatchRunner::save() const {
+    Auxiliar::saveRequestRecord(requestRecord);
+    Auxiliar::saveRequests(waitlist.getRequests(), "../waitlist.txt");
+}
+
+/**
+ * @brief Makes the Course as it is now the new baseline: writes the enrollments of the students (and the UC's, Classes
+ * and Lectures, with all) back to the data files and empties the request history, so the next start only reads the
+ * data files instead of redoing every request. The History starts again from the Course as it is now. The waitlist is
+ * kept.
+ * @param all also writes classes_per_uc.csv and classes.csv
+ * @return false if a data file couldn't be written, the request history is then kept
+ * @details Time Complexity O(c + e + r) c = number of Classes, e = number of enrollments, r = number of requests done
+ * @note Each data file is replaced atomically and the history is only emptied after all of them are. The requests
+ * done can't be undone afterwards.
+ */
+bool BatchRunner::rebase(bool all) {
+    if (all && (!Auxiliar::writeClassesPerUc(course) || !Auxiliar::writeClasses(course)))
+        return false;
+    if (!Auxiliar::writeStudentsClasses(course))
+        return false;
+    while (!requestRecord.empty()) {
+        delete requestRecord.top();
+        requestRecord.pop();
+    }
+    Auxiliar::saveRequestRecord(requestRecord);
+    history.reset(course, {});
+    return true;
+}
+
+/**
+ * @brief Gets the Course the requests change
+ */
+const Course& BatchRunner::getCourse() const {
+    return course;
+}
+
+/**
+ * @brief Runs a command and writes its result. Empty lines and comments are skipped.
+ * @param line command
+ * @param lineNumber number of the line of the command, written with the result
+ * @param os stream the result is written to
+ * @param view Course the consults read, e.g. a snapshot of the Course (see Course::clone). nullptr to read the Course
+ * being changed.
+ * @return false if the command failed
+ * @note Commands that don't change the Course (see changesCourse) can run at the same time in different threads, and
+ * while it changes if they have a view of their own
+ */
+bool BatchRunner::runCommand(std::string line, int lineNumber, std::ostream &os, const Course *view) {
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+    if (line.empty() || line[0] == '#')
+        return true;
+    std::vector<std::string> command = split(line);
+    Result result = execute(command, view == nullptr ? course : *view);
+    write(os, lineNumber, command[0], result);
+    return result.status != "error";
+}
+
+/**
+ * @brief Checks if a command may change the Course, the requests done or the waitlist (requests, files of requests and
+ * undos, rebases and compactions), the other commands only read them
+ * @param line command
+ */
+bool BatchRunner::changesCourse(const std::string &line) {
+    std::string name = line.substr(0, line.find(','));
+    return name == "Join" || name == "Leave" || name == "SwitchUc" || name == "SwitchClass" || name == "RequestFile" || name == "Undo"
+           || name == "Rebase" || name == "Compact";
+}
+
+/**
+ * @brief Runs a command
+ * @param command name of the command followed by its arguments
+ * @param view Course the consults read, the requests change the Course of the BatchRunner
+ * @return result of the command
+ */
+BatchRunner::Result BatchRunner::execute(const std::vector<std::string> &command, const Course &view) {
+    const std::string &name = command[0];
+    size_t arguments = command.size() - 1;
+    auto usage = [&name](const std::string &expected) {
+        return error("usage: " + name + (expected.empty() ? "" : "," + expected));
+    };
+
+    if (name == "UCsInYear") {
+        if (arguments != 1)
+            return usage("year");
+        std::vector<UC> UCs;
+        {
+            METRICS_TIMER(QUERY_UCS_IN_YEAR);
+            UCs = view.getUCsInYear(command[1]);
+        }
+        Result result;
+        result.columns = {"uc"};
+        for (const UC &uc : UCs)
+            result.rows.push_back({uc.getUcCode()});
+        return result;
+    }
+    if (name == "ClassesInUC") {
+        if (arguments != 1)
+            return usage("ucCode");
+        std::vector<Class> classes;
+        {
+            METRICS_TIMER(QUERY_CLASSES_IN_UC);
+            classes = view.getClassesInUC(command[1]);
+        }
+        Result result;
+        result.columns = {"class"};
+        for (const Class &class_ : classes)
+            result.rows.push_back({class_.getClassCode()});
+        return result;
+    }
+    if (name == "StudentClasses") {
+        if (arguments != 1)
+            return usage("studentCode");
+        if (view.findStudentByCode(command[1]) == nullptr)
+            return error("Student " + command[1] + " is not registered in the course.");
+        std::set<Class> classes;
+        {
+            METRICS_TIMER(QUERY_STUDENT_CLASSES);
+            classes = view.getStudentClasses(command[1]);
+        }
+        Result result;
+        result.columns = {"uc", "class"};
+        for (const Class &class_ : classes)
+            result.rows.push_back({class_.getUC(), class_.getClassCode()});
+        return result;
+    }
+    if (name == "StudentsInCourse") {
+        if (arguments != 0)
+            return usage("");
+        METRICS_TIMER(QUERY_STUDENTS_IN_COURSE);
+        return students(view.getStudentsInCourse());
+    }
+    if (name == "StudentsInYear") {
+        if (arguments != 1)
+            return usage("year");
+        METRICS_TIMER(QUERY_STUDENTS_IN_YEAR);
+        return students(view.getStudentsInYear(command[1]));
+    }
+    if (name == "StudentsInUC") {
+        if (arguments != 1)
+            return usage("ucCode");
+        METRICS_TIMER(QUERY_STUDENTS_IN_UC);
+        return students(view.getStudentsInUC(command[1]));
+    }
+    if (name == "StudentsInClass") {
+        if (arguments != 2)
+            return usage("ucCode,classCode");
+        METRICS_TIMER(QUERY_STUDENTS_IN_CLASS);
+        return students(view.getStudentsInClass(command[2], command[1]));
+    }
+    if (name == "StudentsInAtLeastUCs") {
+        if (arguments != 1 || command[1].empty() || command[1].size() > 9 || !std::all_of(command[1].begin(), command[1].end(), ::isdigit))
+            return usage("n");
+        METRICS_TIMER(QUERY_STUDENTS_IN_AT_LEAST_UCS);
+        return students(view.getStudentsInAtLeastUCs(std::stoi(command[1])));
+    }
+    if (name == "StudentSchedule") {
+        if (arguments != 1)
+            return usage("studentCode");
+        if (view.findStudentByCode(command[1]) == nullptr)
+            return error("Student " + command[1] + " is not registered in the course.");
+        METRICS_TIMER(QUERY_STUDENT_SCHEDULE);
+        return schedule(view.getStudentSchedule(command[1]));
+    }
+    if (name == "ClassSchedule") {
+        if (arguments != 1)
+            return usage("classCode");
+        METRICS_TIMER(QUERY_CLASS_SCHEDULE);
+        return schedule(view.getClassSchedule(command[1]));
+    }
+    if (name == "UcSchedule") {
+        if (arguments != 1)
+            return usage("ucCode");
+        METRICS_TIMER(QUERY_UC_SCHEDULE);
+        return schedule(view.getUcSchedule(command[1]));
+    }
+    if (name == "Occupation") {
+        if (arguments != 1 || (command[1] != "classes" && command[1] != "ucs" && command[1] != "years"))
+            return usage("classes|ucs|years");
+        return occupation(view, command[1]);
+    }
+    if (name == "FreeTime")
+        return freeTime(view, command);
+    if (name == "InSession") {
+        if (arguments != 2)
+            return usage("weekday,hour");
+        return inSession(view, command[1], command[2]);
+    }
+    if (name == "Calendar") {
+        if (arguments < 3 || arguments > 5 || (command[1] != "student" && command[1] != "class" && command[1] != "uc"))
+            return usage("student|class|uc,code,path[,termStart[,weeks]]");
+        return calendar(view, command);
+    }
+    if (name == "Statistics") {
+        if (arguments != 0)
+            return usage("");
+        return statistics();
+    }
+    if (name == "AsOf") {
+        if (arguments < 2)
+            return usage("requests|time,consult");
+        return consultPast(command);
+    }
+    if (name == "RequestFile") {
+        if (arguments != 1)
+            return usage("path");
+        return processRequestFile(command[1]);
+    }
+    if (name == "Undo") {
+        if (arguments != 0)
+            return usage("");
+        return undoLastRequest();
+    }
+    if (name == "Rebase") {
+        if (arguments > 1 || (arguments == 1 && command[1] != "all"))
+            return error("usage: Rebase[,all]");
+        size_t requests = requestRecord.size();
+        if (!rebase(arguments == 1))
+            return error("Couldn't write the data files.");
+        Result result;
+        result.fields = {{"requests", std::to_string(requests)}};
+        return result;
+    }
+    if (name == "Compact") {
+        if (arguments != 0)
+            return usage("");
+        return compactHistory();
+    }
+    if (name == "Join" && (arguments == 2 || arguments == 3))
+        return assessRequest(new JoinRequest(command[1], command[2], arguments == 3 ? command[3] : ""));
+    if (name == "Leave" && arguments == 2)
+        return assessRequest(new LeaveRequest(command[1], command[2]));
+    if (name == "SwitchUc" && arguments == 3)
+        return assessRequest(new SwitchUcRequest(command[1], command[2], command[3]));
+    if (name == "SwitchClass" && arguments == 4)
+        return assessRequest(new SwitchClassRequest(command[1], command[2], command[3], command[4]));
+    if (name == "Join")
+        return usage("studentCode,ucCode[,classCode]");
+    if (name == "Leave")
+        return usage("studentCode,ucCode");
+    if (name == "SwitchUc")
+        return usage("studentCode,ucCodeCurrent,ucCodeNext");
+    if (name == "SwitchClass")
+        return usage("studentCode,ucCode,classCodeCurrent,classCodeNext");
+    return error("unknown command " + name);
+}
+
+/**
+ * @brief Result with a table of students, ordered by code
+ * @param students
+ */
+BatchRunner::Result BatchRunner::students(std::vector<Student*> students) {
+    std::sort(students.begin(), students.end(), cmp());
+    Result result;
+    result.columns = {"code", "name"};
+    for (const Student *student : students)
+        result.rows.push_back({student->getStudentCode(), student->getName()});
+    return result;
+}
+
+/**
+ * @brief Result with a table of the lectures of a schedule, in the order of the week
+ * @param schedule
+ */
+BatchRunner::Result BatchRunner::schedule(const Schedule &schedule) {
+    Result result;
+    result.columns = {"weekday", "start", "end", "uc", "class", "type"};
+    for (const Lecture &lecture : schedule.getLectures()) {
+        result.rows.push_back({Timeslots::getWeekdayName(lecture.getWeekday()), formatNumber(lecture.getStartHour()),
+                               formatNumber(lecture.getEndHour()), lecture.getUC(), lecture.getClass(), lecture.getType()});
+    }
+    return result;
+}
+
+/**
+ * @brief Writes the schedule of a student, class or UC as an iCalendar file, streamed to the file as it is written
+ * @param view Course consulted
+ * @param command "Calendar", "student", "class" or "uc", the code, the path of the file and optionally the first day
+ * of the term and its number of weeks
+ * @return result with the path and the number of events written
+ * @details Time Complexity O(l) l = number of lectures of the schedule, plus getting the schedule
+ */
+BatchRunner::Result BatchRunner::calendar(const Course &view, const std::vector<std::string> &command) {
+    const std::string &kind = command[1], &code = command[2], &path = command[3];
+    int weeks = IcsWriter::DEFAULT_WEEKS;
+    if (command.size() > 5) {
+        const std::string &count = command[5];
+        if (count.empty() || count.size() > 2 || !std::all_of(count.begin(), count.end(), ::isdigit) || std::stoi(count) == 0)
+            return error("Invalid number of weeks " + count + ".");
+        weeks = std::stoi(count);
+    }
+    IcsWriter::Term term = IcsWriter::currentTerm(weeks);
+    if (command.size() > 4 && !IcsWriter::parseTerm(command[4], weeks, term))
+        return error("Invalid first day of the term " + command[4] + ", expected yyyy-mm-dd.");
+
+    Schedule schedule;
+    std::string name;
+    if (kind == "student") {
+        const Student *student = view.findStudentByCode(code);
+        if (student == nullptr)
+            return error("Student " + code + " is not registered in the course.");
+        METRICS_TIMER(QUERY_STUDENT_SCHEDULE);
+        schedule = view.getStudentSchedule(code);
+        name = "Schedule of " + student->getName() + " (" + code + ")";
+    } else if (kind == "class") {
+        METRICS_TIMER(QUERY_CLASS_SCHEDULE);
+        schedule = view.getClassSchedule(code);
+        name = "Schedule of class " + code;
+    } else {
+        METRICS_TIMER(QUERY_UC_SCHEDULE);
+        schedule = view.getUcSchedule(code);
+        name = "Schedule of UC " + code;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        return error("Couldn't open file " + path + ".");
+    IcsWriter writer(file, term);
+    writer.begin(name);
+    writer.writeSchedule(schedule);
+    writer.end();
+    file.flush();
+    if (!file)
+        return error("Couldn't write file " + path + ".");
+    Result result;
+    result.fields = {{"path", path}, {"events", std::to_string(writer.getEvents())}};
+    return result;
+}
+
+/**
+ * @brief Result with the number of students of each class, UC or year, and of the course. For the UC's, also the
+ * difference between the most and the least occupied of their classes.
+ * @param view
+ * @param level "classes", "ucs" or "years"
+ */
+BatchRunner::Result BatchRunner::occupation(const Course &view, const std::string &level) {
+    Result result;
+    result.fields = {{"students", std::to_string(view.getOccupation())}};
+    if (level == "classes") {
+        std::vector<Class> classes;
+        {
+            METRICS_TIMER(QUERY_CLASS_OCCUPATION);
+            classes = view.getClasses();
+        }
+        result.columns = {"year", "uc", "class", "students"};
+        for (const Class &class_ : classes)
+            result.rows.push_back({class_.getYear(), class_.getUC(), class_.getClassCode(), std::to_string(class_.getOccupation())});
+    }
+    else if (level == "ucs") {
+        std::vector<UC> UCs;
+        {
+            METRICS_TIMER(QUERY_UC_OCCUPATION);
+            UCs = view.getUCs();
+        }
+        result.columns = {"year", "uc", "students", "spread"};
+        for (const UC &uc : UCs)
+            result.rows.push_back({uc.getYear(), uc.getUcCode(), std::to_string(uc.getOccupation()),
+                                   std::to_string(uc.getOccupationSpread())});
+    }
+    else {
+        std::vector<std::pair<std::string, int>> yearOccupation;
+        {
+            METRICS_TIMER(QUERY_YEAR_OCCUPATION);
+            yearOccupation = view.getYearOccupation();
+        }
+        result.columns = {"year", "students"};
+        for (const auto &[year, students] : yearOccupation)
+            result.rows.push_back({year, std::to_string(students)});
+    }
+    return result;
+}
+
+/**
+ * @brief Result with the number of students of a group free in each half hour of the week, and if all of them are
+ * @param view
+ * @param command FreeTime followed by the group: "students" and the student codes, "class" and the UC and class codes,
+ * or "uc" and the UC code
+ */
+BatchRunner::Result BatchRunner::freeTime(const Course &view, const std::vector<std::string> &command) {
+    std::string kind = command.size() > 1 ? command[1] : "";
+    std::vector<Student*> students;
+    std::vector<std::string> unknown;
+    if (kind == "students" && command.size() > 2) {
+        std::set<std::string> codes;
+        for (size_t i = 2; i < command.size(); i++) {
+            Student *student = view.findStudentByCode(command[i]);
+            if (student == nullptr)
+                unknown.push_back(command[i]);
+            else if (codes.insert(command[i]).second)
+                students.push_back(student);
+        }
+    }
+    else if (kind == "class" && command.size() == 4)
+        students = view.getStudentsInClass(command[3], command[2]);
+    else if (kind == "uc" && command.size() == 3)
+        students = view.getStudentsInUC(command[2]);
+    else
+        return error("usage: FreeTime,students,studentCode... or FreeTime,class,ucCode,classCode or FreeTime,uc,ucCode");
+
+    Timeslots::Mask commonFree;
+    std::vector<int> available;
+    {
+        METRICS_TIMER(QUERY_GROUP_AVAILABILITY);
+        commonFree = view.getCommonFreeSlots(students);
+        available = view.getSlotAvailability(students);
+    }
+    Result result;
+    std::string unknownCodes;
+    for (const std::string &code : unknown)
+        unknownCodes += (unknownCodes.empty() ? "" : " ") + code;
+    result.fields = {{"students", std::to_string(students.size())}, {"unknown", unknownCodes}};
+    result.columns = {"weekday", "start", "end", "free", "everyone"};
+    for (int slot = 0; slot < Timeslots::SLOTS; slot++) {
+        float hour = Timeslots::getHour(slot);
+        result.rows.push_back({Timeslots::getWeekdayName(Timeslots::getWeekday(slot)), formatNumber(hour),
+                               formatNumber(hour + 0.5), std::to_string(available[slot]), commonFree[slot] ? "yes" : "no"});
+    }
+    return result;
+}
+
+/**
+ * @brief Result with the lectures in session at a time, and the number of students attending them
+ * @param view
+ * @param weekday name of the weekday
+ * @param hour e.g. 10.5 for 10:30
+ */
+BatchRunner::Result BatchRunner::inSession(const Course &view, const std::string &weekday, const std::string &hour) {
+    int day = Timeslots::parseWeekday(weekday);
+    float time;
+    std::istringstream hourStream(hour);
+    if (day == -1 || !(hourStream >> time) || !hourStream.eof())
+        return error("usage: InSession,weekday,hour");
+    Result result;
+    result.columns = {"uc", "type", "class", "start", "end", "students"};
+    if (time < Timeslots::FIRST_HOUR || time >= Timeslots::LAST_HOUR) {
+        result.fields = {{"students", "0"}};
+        return result;
+    }
+    std::vector<std::pair<const Lecture*, const Class*>> lectures;
+    int studentsInSession;
+    {
+        METRICS_TIMER(QUERY_IN_SESSION);
+        lectures = view.getLecturesAt(day, time);
+        studentsInSession = view.getStudentsInSessionAt(day, time);
+    }
+    result.fields = {{"students", std::to_string(studentsInSession)}};
+    for (const auto &[lecture, class_] : lectures) {
+        result.rows.push_back({lecture->getUC(), lecture->getType(), lecture->getClass(), formatNumber(lecture->getStartHour()),
+                               formatNumber(lecture->getEndHour()), std::to_string(class_->getOccupation())});
+    }
+    return result;
+}
+
+/**
+ * @brief Result with the latencies (in microseconds) of the code paths that ran and the number of requests rejected
+ * for each reason
+ */
+BatchRunner::Result BatchRunner::statistics() {
+    if (!Metrics::enabled())
+        return error("Statistics are not available, the program was built without PROJETO_METRICS.");
+    Result result;
+    for (int rejection = Request::ACCEPTED + 1; rejection < Request::REJECTION_COUNT; rejection++) {
+        result.fields.emplace_back(Request::getRejectionName((Request::Rejection) rejection),
+                                   std::to_string(Metrics::getRejections((Request::Rejection) rejection)));
+    }
+    result.columns = {"point", "count", "mean", "p50", "p90", "p99", "max"};
+    for (int point = 0; point < Metrics::POINT_COUNT; point++) {
+        const LatencyHistogram &histogram = Metrics::getHistogram((Metrics::Point) point);
+        if (histogram.getCount() == 0)
+            continue;
+        result.rows.push_back({Metrics::getPointName((Metrics::Point) point), std::to_string(histogram.getCount()),
+                               formatNumber(histogram.getMean() / 1000), formatNumber(histogram.getPercentile(50) / 1000.0),
+                               formatNumber(histogram.getPercentile(90) / 1000.0), formatNumber(histogram.getPercentile(99) / 1000.0),
+                               formatNumber(histogram.getMax() / 1000.0)});
+    }
+    return result;
+}
+
+/**
+ * @brief Sends the request to course so that it can be assessed. A request rejected because a class is full waits in
+ * the waitlist, and the seats freed by a request accepted are given to the requests waiting.
+ * @param request Request to be assessed, the BatchRunner takes ownership of it
+ * @return result with the request, the reason if it was rejected and its position in the waitlist if it waits. Its
+ * rows are the requests done from the waitlist.
+ */
+BatchRunner::Result BatchRunner::assessRequest(Request *request) {
+    Result result;
+    result.columns = {"request", "status", "reason"};
+    bool accepted = course.assessRequest(request);
+    std::string line = Auxiliar::formatRequest(request);        // With the class chosen for a join
+    std::string reason;
+    size_t position = 0;
+    if (accepted) {
+        result.status = "accepted";
+        if (!request->isUndo()) {
+            requestRecord.push(request);
+            history.record(request);
+        }
+        else
+            delete request;
+        promoteWaitlist(result);
+    } else {
+        result.status = "rejected";
+        reason = Request::getRejectionName(request->getRejection());
+        if (!request->isUndo() && Waitlist::canWait(request))
+            position = waitlist.add(request);
+        if (position > 0)
+            result.status = "waitlisted";
+        else
+            delete request;
+    }
+    result.fields = {{"request", line}, {"reason", reason}, {"position", std::to_string(position)}};
+    return result;
+}
+
+/**
+ * @brief Assesses every request of a file together, see Course::assessRequestBatch.
+ * @param path file with one request per line, in the format of the request history
+ * @return result with the number of requests read and accepted, and a row for each request
+ */
+BatchRunner::Result BatchRunner::processRequestFile(const std::string &path) {
+    std::queue<Request*> requests;
+    Auxiliar::loadRequestRecord(requests, path);
+    std::vector<Request*> batch;
+    for (; !requests.empty(); requests.pop())
+        batch.push_back(requests.front());
+    course.assessRequestBatch(batch);
+
+    Result result;
+    result.columns = {"request", "status", "reason"};
+    int accepted = 0;
+    for (Request *request : batch) {
+        if (request->getRejection() == Request::ACCEPTED) {
+            result.rows.push_back({Auxiliar::formatRequest(request), "accepted", ""});
+            requestRecord.push(request);
+            history.record(request);
+            accepted++;
+            continue;
+        }
+        bool waits = Waitlist::canWait(request) && waitlist.add(request) > 0;
+        result.rows.push_back({Auxiliar::formatRequest(request), waits ? "waitlisted" : "rejected",
+                               Request::getRejectionName(request->getRejection())});
+        if (!waits)
+            delete request;
+    }
+    result.fields = {{"read", std::to_string(batch.size())}, {"accepted", std::to_string(accepted)}};
+    promoteWaitlist(result);
+    return result;
+}
+
+/**
+ * @brief Undoes the last request
+ * @return result of the request that undoes it, an error if there is no request to undo
+ */
+BatchRunner::Result BatchRunner::undoLastRequest() {
+    if (requestRecord.empty())
+        return error("There is no request to undo.");
+    Request *request = requestRecord.top();
+    requestRecord.pop();
+    history.undo();
+    Result result = assessRequest(request->getUndoRequest());
+    delete request;
+    return result;
+}
+
+/**
+ * @brief Replaces the requests done by the compacted history, if it gives the same Course (see HistoryCompactor). The
+ * request history saved is then the compacted one, and the requests undone are the ones of the compacted history.
+ * @return result with the size of both histories, how long redoing each one takes (ms) and if the compacted one gives
+ * the same Course
+ * @details Time Complexity O(HistoryCompactor::compact)
+ */
+BatchRunner::Result BatchRunner::compactHistory() {
+    std::unique_ptr<Course> baseline = history.getCourseAfter(0);
+    std::vector<std::string> requests, compacted;
+    for (size_t n = 1; n <= history.size(); n++)
+        requests.push_back(history.getRequest(n));
+    HistoryCompactor::Report report = HistoryCompactor(*baseline).compact(requests, compacted);
+    if (report.after < report.before) {
+        while (!requestRecord.empty()) {
+            delete requestRecord.top();
+            requestRecord.pop();
+        }
+        std::vector<Request*> redone;
+        for (const std::string &line : compacted) {
+            Request *request = Auxiliar::parseRequest(line);
+            if (request != nullptr) {
+                redone.push_back(request);
+                requestRecord.push(request);
+            }
+        }
+        history.reset(*baseline, redone);
+    }
+    Result result;
+    result.fields = {{"before", std::to_string(report.before)}, {"after", std::to_string(report.after)},
+                     {"msBefore", formatNumber(report.secondsBefore * 1000)}, {"msAfter", formatNumber(report.secondsAfter * 1000)},
+                     {"verified", report.verified ? "true" : "false"}};
+    return result;
+}
+
+/**
+ * @brief Gives the seats freed by the last requests to the requests in the waitlist, and adds the ones done to the rows
+ * of a result
+ * @param result
+ */
+void BatchRunner::promoteWaitlist(Result &result) {
+    for (Request *request : waitlist.promote(course)) {
+        result.rows.push_back({Auxiliar::formatRequest(request), "promoted", ""});
+        requestRecord.push(request);
+        history.record(request);
+    }
+}
+
+/**
+ * @brief Runs a consult on the Course as it was after a number of requests, or at a time (see History::parsePoint)
+ * @param command "AsOf", the point of the history and the consult
+ * @return result of the consult, with the number of requests done at that point and the last of them
+ */
+BatchRunner::Result BatchRunner::consultPast(const std::vector<std::string> &command) {
+    size_t count;
+    if (!history.parsePoint(command[1], count))
+        return error("There is no point " + command[1] + " in the history of " + std::to_string(history.size()) + " requests.");
+    std::vector<std::string> consult(command.begin() + 2, command.end());
+    if (changesCourse(consult[0]) || consult[0] == "AsOf" || consult[0] == "Statistics")
+        return error("Only consults of the Course can be done as of a past request.");
+    std::unique_ptr<Course> past = history.getCourseAfter(count);
+    Result result = execute(consult, *past);
+    result.fields.insert(result.fields.begin(), {{"requests", std::to_string(count)}, {"lastRequest", history.getRequest(count)}});
+    return result;
+}
+
+/**
+ * @brief Writes the result of a command. In CSV, each row of the result is a line with the line of the command, its
+ * name, its status, the values of its fields and the values of the row (a result without rows is a single line). In
+ * JSON Lines, the result is an object with the line, command, status, fields and an array of rows.
+ * @param os
+ * @param line number of the line of the command
+ * @param command name of the command
+ * @param result
+ * @details Time Complexity O(n) n = size of the result
+ */
+void BatchRunner::write(std::ostream &os, int line, const std::string &command, const Result &result) const {
+    if (format == CSV) {
+        std::string prefix = std::to_string(line) + "," + csvField(command) + "," + result.status;
+        for (const auto &[key, value] : result.fields)
+            prefix += "," + csvField(value);
+        if (result.rows.empty())
+            os << prefix << "\n";
+        for (const std::vector<std::string> &row : result.rows) {
+            os << prefix;
+            for (const std::string &value : row)
+                os << "," << csvField(value);
+            os << "\n";
+        }
+        return;
+    }
+    os << "{\"line\":" << line << ",\"command\":" << jsonString(command) << ",\"status\":" << jsonString(result.status);
+    for (const auto &[key, value] : result.fields)
+        os << "," << jsonString(key) << ":" << jsonString(value);
+    if (!result.columns.empty()) {
+        os << ",\"rows\":[";
+        for (size_t row = 0; row < result.rows.size(); row++) {
+            os << (row == 0 ? "{" : ",{");
+            for (size_t column = 0; column < result.columns.size(); column++)
+                os << (column == 0 ? "" : ",") << jsonString(result.columns[column]) << ":" << jsonString(result.rows[row][column]);
+            os << "}";
+        }
+        os << "]";
+    }
+    os << "}\n";
+}
+
+/**
+ * @brief Result of a command that failed
+ * @param message why it failed
+ */
+BatchRunner::Result BatchRunner::error(const std::string &message) {
+    Result result;
+    result.status = "error";
+    result.fields = {{"message", message}};
+    return result;
+}
+
+/**
+ * @brief Splits a command into its fields, separated by commas
+ * @param line
+ */
+std::vector<std::string> BatchRunner::split(const std::string &line) {
+    std::vector<std::string> fields;
+    std::istringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+        fields.push_back(field);
+    if (fields.empty() || line.back() == ',')
+        fields.emplace_back();
+    return fields;
+}
+
+/**
+ * @brief Writes a number with up to 3 decimal places, without trailing zeros (e.g. hours as 10.5)
+ * @param number
+ */
+std::string BatchRunner::formatNumber(double number) {
+    std::ostringstream oss;
+    oss << std::fixed;
+    oss.precision(3);
+    oss << number;
+    std::string str = oss.str();
+    str.erase(str.find_last_not_of('0') + 1);
+    if (str.back() == '.')
+        str.pop_back();
+    return str;
+}
+
+/**
+ * @brief Quotes a CSV field if it has commas, quotes or line breaks
+ * @param field
+ */
+std::string BatchRunner::csvField(const std::string &field) {
+    if (field.find_first_of(",\"\n\r") == std::string::npos)
+        return field;
+    std::string quoted = "\"";
+    for (char c : field) {
+        if (c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+/**
+ * @brief Writes a string as a JSON string, with quotes and escapes
+ * @param str
+ */
+std::string BatchRunner::jsonString(const std::string &str) {
+    std::string json = "\"";
+    for (char c : str) {
+        switch (c) {
+            case '"': json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            case '\n': json += "\\n"; break;
+            case '\r': json += "\\r"; break;
+            case '\t': json += "\\t"; break;
+            default:
+                if ((unsigned char) c < 0x20) {
+                    char escaped[7];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    json += escaped;
+                }
+                else
+                    json += c;
+        }
+    }
+    return json + "\"";
+}
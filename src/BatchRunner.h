@@ -0,0 +1,106 @@
+#ifndef PROJETO_BATCHRUNNER_H
+#define PROJETO_BATCHRUNNER_H
+
+
+#include <iostream>
+#include <stack>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Course.h"
+#include "Waitlist.h"
+#include "History.h"
+
+/**
+ * @brief BatchRunner runs commands without the interactive interface, e.g. from a script: one command per line, with
+ * the fields separated by commas, and one result per command in CSV or JSON Lines. It offers every consult and request
+ * of the Terminal menu. The requests are written like in the request history (so a history is also a file of
+ * commands), the request history and the waitlist are loaded and saved like the Terminal does.
+ *
+ * Commands:
+ *  UCsInYear,year                      ClassesInUC,ucCode                   StudentClasses,studentCode
+ *  StudentsInCourse                    StudentsInYear,year                  StudentsInUC,ucCode
+ *  StudentsInClass,ucCode,classCode    StudentsInAtLeastUCs,n
+ *  StudentSchedule,studentCode         ClassSchedule,classCode              UcSchedule,ucCode
+ *  Occupation,classes|ucs|years        FreeTime,students,studentCode...     FreeTime,class,ucCode,classCode
+ *  FreeTime,uc,ucCode                  InSession,weekday,hour               Statistics
+ *  Join,studentCode,ucCode[,classCode] Leave,studentCode,ucCode             SwitchUc,studentCode,ucCodeCurrent,ucCodeNext
+ *  SwitchClass,studentCode,ucCode,classCodeCurrent,classCodeNext            RequestFile,path
+ *  Undo                                AsOf,requests|time,consult         (e.g. AsOf,120,StudentSchedule,202025232)
+ *  Calendar,student|class|uc,code,path[,termStart[,weeks]]   writes the schedule as an iCalendar file (see IcsWriter)
+ *  Rebase[,all]                        writes the enrollments back to the data files and empties the request history
+ *  Compact                             replaces the requests done by the fewest with the same effect (see HistoryCompactor)
+ * Empty lines and lines starting with '#' are skipped.
+ */
+
+class BatchRunner {
+public:
+    enum Format { CSV, JSONL };
+
+private:
+    /**
+     * @brief Result of a command: its status ("ok", "error", "accepted", "rejected" or "waitlisted"), fields and a
+     * table of rows
+     */
+    struct Result {
+        std::string status = "ok";
+        std::vector<std::pair<std::string, std::string>> fields;
+        std::vector<std::string> columns;
+        std::vector<std::vector<std::string>> rows;
+    };
+
+    Course course;
+    /**
+     * @brief Requests accepted, stored by chronological order
+     */
+    std::stack<Request*> requestRecord;
+    /**
+     * @brief Requests rejected because a class was full, waiting for a seat
+     */
+    Waitlist waitlist;
+    /**
+     * @brief Requests done, to consult the Course as it was after any of them
+     */
+    History history;
+    Format format;
+    std::ostream &out;
+
+    Result execute(const std::vector<std::string> &command, const Course &view);
+    Result assessRequest(Request *request);
+    Result processRequestFile(const std::string &path);
+    Result undoLastRequest();
+    Result compactHistory();
+    Result consultPast(const std::vector<std::string> &command);
+    void promoteWaitlist(Result &result);
+    void write(std::ostream &os, int line, const std::string &command, const Result &result) const;
+
+    static Result students(std::vector<Student*> students);
+    static Result schedule(const Schedule &schedule);
+    static Result occupation(const Course &view, const std::string &level);
+    static Result freeTime(const Course &view, const std::vector<std::string> &command);
+    static Result inSession(const Course &view, const std::string &weekday, const std::string &hour);
+    static Result calendar(const Course &view, const std::vector<std::string> &command);
+    static Result statistics();
+    static Result error(const std::string &message);
+    static std::vector<std::string> split(const std::string &line);
+    static std::string formatNumber(double number);
+    static std::string csvField(const std::string &field);
+    static std::string jsonString(const std::string &str);
+
+public:
+    BatchRunner(Course &&course, Format format = CSV, std::ostream &out = std::cout);
+    BatchRunner(const BatchRunner &runner) = delete;
+    BatchRunner& operator=(const BatchRunner &runner) = delete;
+    ~BatchRunner();
+    int run(std::istream &commands);
+    void load();
+    void save() const;
+    bool rebase(bool all);
+    const Course& getCourse() const;
+    bool runCommand(std::string line, int lineNumber, std::ostream &os, const Course *view = nullptr);
+    static bool changesCourse(const std::string &line);
+    static bool parseFormat(const std::string &name, Format &format);
+};
+
+
+#endif //PROJETO_BATCHRUNNER_H
@@ -4,16 +4,17 @@
  * @brief Constructor of the Class
  * @param classCode
  * @param uc
+ * @param index index of the Class in the Course, -1 for a Class used only to search
  */
-Class::Class(std::string classCode, std::string uc):classCode(classCode),uc(uc) {
-    this->year=classCode.at(0);
+Class::Class(std::string classCode, std::string uc, int index):classCode(std::move(classCode)),uc(std::move(uc)),index(index) {
+    this->year=this->classCode.at(0);
 }
 
 /**
  * @brief Gets the code of the Class
  * @return classCode
  */
-std::string Class::getClassCode() const {
+const std::string& Class::getClassCode() const {
     return classCode;
 }
 
@@ -21,7 +22,7 @@ std::string Class::getClassCode() const {
  * @brief Gets the UC which the Class is registered
  * @return uc
  */
-std::string Class::getUC() const {
+const std::string& Class::getUC() const {
     return uc;
 }
 
@@ -29,18 +30,27 @@ std::string Class::getUC() const {
  * @brief Gets the year of the Class
  * @return year
  */
-std::string Class::getYear() const {
+const std::string& Class::getYear() const {
     return year;
 }
 
+/**
+ * @brief Gets the index of the Class in the Course
+ * @return index, -1 if the Class isn't part of a Course
+ */
+int Class::getIndex() const {
+    return index;
+}
+
 /**
  * @brief Adds Student to the Class
  * @param student
- * @note Also adds the Class Lecture to the Student Schedule
+ * @note Also adds the Class Lecture to the Student Schedule, and the Class to the Classes of the Student
  * @details Time Complexity O(n log m) n = number of lectures of Class schedule, m =number of lectures of student schedule
  */
 void Class::addStudent(Student* student) {
     students.insert(student);
+    student->joinClass(index);
     for (const Lecture &newLecture : schedule.getLectures()) {
         student->addLecture(newLecture);
     }
@@ -57,40 +67,66 @@ void Class::addStudent(Student* student) {
  * @note Also adds the Lecture to the Schedule of all the Students of the Class
  * @details Time Complexity O(n log m) n= number of students of the Class, m= number of lectures of student schedule
  */
-void Class::addLecture(std::string classCode,std::string ucCode,std::string weekday,float startHour,float duration,std::string type){
-    Lecture newLecture(classCode,ucCode,weekday,startHour,duration,type);
-    schedule.addLecture(newLecture);
+void Class::addLecture(std::string classCode,std::string ucCode,const std::string &weekday,float startHour,float duration,std::string type){
+    Lecture newLecture(std::move(classCode),std::move(ucCode),weekday,startHour,duration,std::move(type));
     for (Student* student : students) {
        student->addLecture(newLecture);
     }
+    schedule.addLecture(std::move(newLecture));
 }
 
 /**
  * @brief Removes Student from Class
  * @param student
- * @note Also removes the Lectures of the Class from the Student Schedule
+ * @note Also removes the Lectures of the Class from the Student Schedule, and the Class from the Classes of the Student
  * @details Time Complexity O(n log m) n = number of lectures of Class schedule, m =number of lectures of student schedule
  */
 void Class::removeStudent(Student* student) {
     students.erase(student);
+    student->leaveClass(index);
     for (const Lecture &lecture : schedule.getLectures()) {
         student->removeLecture(lecture);
     }
 }
 
+/**
+ * @brief Removes a Lecture from the Class Schedule
+ * @param lecture
+ * @note Also removes the Lecture from the Schedule of all the Students of the Class
+ * @details Time Complexity O(n log m) n= number of students of the Class, m= number of lectures of student schedule
+ */
+void Class::removeLecture(const Lecture &lecture) {
+    for (Student* student : students) {
+        student->removeLecture(lecture);
+    }
+    schedule.removeLecture(lecture);
+}
+
 /**
  * @brief Gets the Students registered in the Class
  * @return students
  */
-std::set<Student*, cmp> Class::getStudents() const {
+const std::set<Student*, cmp>& Class::getStudents() const {
     return students;
 }
 
+/**
+ * @brief Points the Class to copies of its Students, e.g. the ones of a copy of the Course
+ * @param copies copy of each Student, must have every Student of the Class
+ * @details Time Complexity O(n) n = number of students of the Class
+ */
+void Class::relinkStudents(const std::unordered_map<const Student*, Student*> &copies) {
+    std::set<Student*, cmp> relinked;
+    for (const Student *student : students)
+        relinked.insert(relinked.end(), copies.at(student));
+    students = std::move(relinked);
+}
+
 /**
  * @brief Gets the Schedule of the Class
  * @return schedule
  */
-Schedule Class::getSchedule()const {
+const Schedule& Class::getSchedule()const {
     return schedule;
 }
 
@@ -2,6 +2,7 @@
 #define PROJETO_CLASS_H
 
 
+#include <unordered_map>
 #include "Student.h"
 
 /**
@@ -14,21 +15,28 @@ private:
     std::string classCode;
     std::string uc;
     std::string year;
+    /**
+     * Index of the Class in the Course (e.g. in its ConflictMatrix), -1 for a Class used only to search
+     */
+    int index;
     Schedule schedule;
     std::set<Student*, cmp> students;
 
 public:
 
-    Class(std::string classCode, std::string uc);
-    std::string getClassCode() const;
-    std::string getUC() const;
-    std::string getYear() const;
+    Class(std::string classCode, std::string uc, int index = -1);
+    const std::string& getClassCode() const;
+    const std::string& getUC() const;
+    const std::string& getYear() const;
+    int getIndex() const;
     int getOccupation() const;
     void addStudent(Student* student);
-    void addLecture(std::string classCode,std::string ucCode,std::string weekday,float startHour,float duration,std::string type);
+    void addLecture(std::string classCode,std::string ucCode,const std::string &weekday,float startHour,float duration,std::string type);
     void removeStudent(Student* student);
-    std::set<Student*, cmp> getStudents() const;
-    Schedule getSchedule() const;
+    void removeLecture(const Lecture &lecture);
+    const std::set<Student*, cmp>& getStudents() const;
+    void relinkStudents(const std::unordered_map<const Student*, Student*> &copies);
+    const Schedule& getSchedule() const;
     bool operator<(const Class& class_) const;
 
 };
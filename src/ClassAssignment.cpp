@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <queue>
+#include "ClassAssignment.h"
+
+/**
+ * @brief Constructor of an empty ClassAssignment
+ * @param classCap maximum number of students of a Class
+ * @param maxSpread maximum difference between the most and the least occupied Classes after the assignment, unless
+ * the difference was already bigger
+ */
+ClassAssignment::ClassAssignment(int classCap, int maxSpread) : classCap(classCap), maxSpread(maxSpread), limitedByBalance(false) {}
+
+/**
+ * @brief Adds a Class to the assignment
+ * @param occupation number of students the Class already has
+ * @return index of the Class
+ */
+int ClassAssignment::addClass(int occupation) {
+    occupations.push_back(occupation);
+    return (int) occupations.size() - 1;
+}
+
+/**
+ * @brief Adds a student to the assignment. Students with the same eligible Classes share a node of the network, so its
+ * size depends on the number of different schedules and not on the number of students.
+ * @param eligibleClasses indexes of the Classes the student can join without schedule conflicts
+ * @return index of the student
+ * @details Time Complexity O(k log g) k = number of eligible classes, g = number of groups
+ */
+int ClassAssignment::addStudent(std::vector<int> eligibleClasses) {
+    std::sort(eligibleClasses.begin(), eligibleClasses.end());
+    auto group = groupsByClasses.find(eligibleClasses);
+    if (group == groupsByClasses.end()) {
+        group = groupsByClasses.emplace(eligibleClasses, (int) groupClasses.size()).first;
+        groupClasses.push_back(std::move(eligibleClasses));
+        groupSizes.push_back(0);
+    }
+    groupSizes[group->second]++;
+    studentGroups.push_back(group->second);
+    return (int) studentGroups.size() - 1;
+}
+
+/**
+ * @brief Adds an arc and its reverse, with no capacity, to the network
+ * @param from
+ * @param to
+ * @param capacity
+ * @param cost
+ */
+void ClassAssignment::addArc(int from, int to, int capacity, long cost) {
+    adjacency[from].push_back((int) arcs.size());
+    arcs.push_back({to, capacity, cost});
+    adjacency[to].push_back((int) arcs.size());
+    arcs.push_back({from, 0, -cost});
+}
+
+/**
+ * @brief Sends as much flow as possible from source to sink with the minimum cost (primal-dual). Dijkstra with
+ * potentials finds the cost of the cheapest path, then every path with that cost is saturated at once with blocking
+ * flows (as in Dinic) over the arcs with no reduced cost. The number of phases depends on the number of different seat
+ * costs, not on the number of seats.
+ * @param source
+ * @param sink
+ * @details Time Complexity O(p * (e log v + v^2 e)) p = number of phases (at most classCap), e = number of arcs, v = number of nodes, much less in practice
+ */
+void ClassAssignment::minCostFlow(int source, int sink) {
+    int n = (int) adjacency.size();
+    std::vector<long> potential(n, 0), distance(n);
+    std::vector<int> level(n);
+    std::vector<size_t> nextArc(n);
+    auto reducedCost = [&](int from, const Arc &arc) { return arc.cost + potential[from] - potential[arc.to]; };
+
+    // Augmenting path through arcs with no reduced cost whose level increases by one
+    std::function<int(int, int)> augment = [&](int node, int limit) {
+        if (node == sink)
+            return limit;
+        for (size_t &i = nextArc[node]; i < adjacency[node].size(); i++) {
+            Arc &arc = arcs[adjacency[node][i]];
+            if (arc.capacity == 0 || level[arc.to] != level[node] + 1 || reducedCost(node, arc) != 0)
+                continue;
+            int flow = augment(arc.to, std::min(limit, arc.capacity));
+            if (flow > 0) {
+                arc.capacity -= flow;
+                arcs[adjacency[node][i] ^ 1].capacity += flow;
+                return flow;
+            }
+        }
+        return 0;
+    };
+
+    while (true) {
+        distance.assign(n, LONG_MAX);
+        distance[source] = 0;
+        std::priority_queue<std::pair<long, int>, std::vector<std::pair<long, int>>, std::greater<>> queue;
+        queue.push({0, source});
+        while (!queue.empty()) {
+            auto [d, node] = queue.top();
+            queue.pop();
+            if (d > distance[node])
+                continue;
+            for (int arcIndex : adjacency[node]) {
+                const Arc &arc = arcs[arcIndex];
+                if (arc.capacity == 0)
+                    continue;
+                long next = d + reducedCost(node, arc);
+                if (next < distance[arc.to]) {
+                    distance[arc.to] = next;
+                    queue.push({next, arc.to});
+                }
+            }
+        }
+        if (distance[sink] == LONG_MAX)
+            return;
+        for (int node = 0; node < n; node++)
+            potential[node] += std::min(distance[node], distance[sink]);
+
+        // Blocking flows over the arcs that are now on a cheapest path
+        while (true) {
+            level.assign(n, -1);
+            level[source] = 0;
+            std::queue<int> bfs;
+            bfs.push(source);
+            while (!bfs.empty()) {
+                int node = bfs.front();
+                bfs.pop();
+                for (int arcIndex : adjacency[node]) {
+                    const Arc &arc = arcs[arcIndex];
+                    if (arc.capacity > 0 && level[arc.to] == -1 && reducedCost(node, arc) == 0) {
+                        level[arc.to] = level[node] + 1;
+                        bfs.push(arc.to);
+                    }
+                }
+            }
+            if (level[sink] == -1)
+                break;
+            nextArc.assign(n, 0);
+            while (augment(source, INT_MAX) > 0) {}
+        }
+    }
+}
+
+/**
+ * @brief Builds and solves the network, no Class can get more than ceiling students
+ * @param ceiling
+ * @return Class of each student, -1 if the student wasn't assigned
+ */
+std::vector<int> ClassAssignment::solveWithCeiling(int ceiling) {
+    int groups = (int) groupClasses.size();
+    int classes = (int) occupations.size();
+    int source = 0, sink = 1;
+    arcs.clear();
+    adjacency.assign(2 + groups + classes, {});
+
+    // Arcs from each group to its eligible Classes, kept to read how many students went to each Class
+    std::vector<std::vector<std::pair<int, int>>> groupArcs(groups);
+    for (int group = 0; group < groups; group++) {
+        addArc(source, 2 + group, groupSizes[group], 0);
+        for (int class_ : groupClasses[group]) {
+            groupArcs[group].push_back({class_, (int) arcs.size()});
+            addArc(2 + group, 2 + groups + class_, groupSizes[group], 0);
+        }
+    }
+    // One arc per free seat, taking a seat costs the occupation reached, so the emptiest Classes are filled first
+    for (int class_ = 0; class_ < classes; class_++) {
+        for (int seat = occupations[class_] + 1; seat <= std::min(classCap, ceiling); seat++)
+            addArc(2 + groups + class_, sink, 1, seat);
+    }
+    minCostFlow(source, sink);
+
+    // The first students of each group (the ones who asked first) get the seats
+    std::vector<std::vector<std::pair<int, int>>> groupFlows(groups);
+    for (int group = 0; group < groups; group++) {
+        for (auto [class_, arcIndex] : groupArcs[group]) {
+            int flow = arcs[arcIndex ^ 1].capacity;
+            if (flow > 0)
+                groupFlows[group].push_back({class_, flow});
+        }
+    }
+    std::vector<int> assignment(studentGroups.size(), -1);
+    std::vector<size_t> nextFlow(groups, 0);
+    for (size_t student = 0; student < studentGroups.size(); student++) {
+        int group = studentGroups[student];
+        std::vector<std::pair<int, int>> &flows = groupFlows[group];
+        if (nextFlow[group] == flows.size())
+            continue;
+        assignment[student] = flows[nextFlow[group]].first;
+        if (--flows[nextFlow[group]].second == 0)
+            nextFlow[group]++;
+    }
+    return assignment;
+}
+
+/**
+ * @brief Assigns the students to the Classes: the most students possible, with the Classes as balanced as possible
+ * and never leaving a difference bigger than maxSpread between the most and the least occupied Classes (or bigger than
+ * the one they already had). When the balance rule is broken, the Classes are capped at the least occupation plus
+ * maxSpread and the problem is solved again.
+ * @return Class of each student, -1 if the student wasn't assigned
+ * @details Time Complexity O(r * minCostFlow) r = number of rounds, at most classCap and usually one
+ */
+std::vector<int> ClassAssignment::solve() {
+    limitedByBalance = false;
+    if (occupations.empty())
+        return std::vector<int>(studentGroups.size(), -1);
+    int initialMin = *std::min_element(occupations.begin(), occupations.end());
+    int initialMax = *std::max_element(occupations.begin(), occupations.end());
+    int allowedSpread = std::max(maxSpread, initialMax - initialMin);
+
+    std::vector<int> assignment = solveWithCeiling(classCap);
+    for (int round = 0; round <= classCap; round++) {
+        std::vector<int> finalOccupations = occupations;
+        for (int class_ : assignment) {
+            if (class_ >= 0)
+                finalOccupations[class_]++;
+        }
+        int finalMin = *std::min_element(finalOccupations.begin(), finalOccupations.end());
+        int finalMax = *std::max_element(finalOccupations.begin(), finalOccupations.end());
+        if (finalMax - finalMin <= allowedSpread)
+            return assignment;
+        limitedByBalance = true;
+        assignment = solveWithCeiling(round < classCap ? finalMin + allowedSpread : initialMin + allowedSpread);
+    }
+    return assignment;
+}
+
+/**
+ * @brief Checks if the last solve had to leave seats empty because of the balance rule
+ */
+bool ClassAssignment::isLimitedByBalance() const {
+    return limitedByBalance;
+}
@@ -0,0 +1,52 @@
+#ifndef PROJETO_CLASSASSIGNMENT_H
+#define PROJETO_CLASSASSIGNMENT_H
+
+#include <vector>
+#include <map>
+
+/**
+ * @brief ClassAssignment assigns a batch of students that want to join the same UC to its Classes all at once, instead
+ * of one by one in the order they asked. It is solved as a min-cost max-flow problem:
+ * source -> group of students with the same eligible Classes -> Class -> sink, where each free seat of a Class is an arc
+ * to the sink whose cost is the occupation the Class reaches when it is taken. The most students possible are assigned,
+ * and among those assignments the one that keeps the Classes most balanced is chosen.
+ * @note Students and Classes are identified by their index, in the order they were added
+ */
+
+class ClassAssignment {
+private:
+    /**
+     * @brief Arc of the flow network, stored next to its reverse arc (index ^ 1)
+     */
+    struct Arc {
+        int to;
+        int capacity;
+        long cost;
+    };
+
+    int classCap;
+    int maxSpread;
+    std::vector<int> occupations;
+    std::vector<int> studentGroups;
+    std::vector<std::vector<int>> groupClasses;
+    std::vector<int> groupSizes;
+    std::map<std::vector<int>, int> groupsByClasses;
+    bool limitedByBalance;
+
+    std::vector<Arc> arcs;
+    std::vector<std::vector<int>> adjacency;
+
+    void addArc(int from, int to, int capacity, long cost);
+    void minCostFlow(int source, int sink);
+    std::vector<int> solveWithCeiling(int ceiling);
+
+public:
+    ClassAssignment(int classCap, int maxSpread);
+    int addClass(int occupation);
+    int addStudent(std::vector<int> eligibleClasses);
+    std::vector<int> solve();
+    bool isLimitedByBalance() const;
+};
+
+
+#endif //PROJETO_CLASSASSIGNMENT_H
@@ -0,0 +1,146 @@
+#include "ConflictMatrix.h"
+
+/**
+ * @brief Adds a Class without Lectures, it conflicts with no Class
+ * @return index of the Class
+ * @details Time Complexity O(n) amortized, n = number of Classes, the rows grow a word every 64 Classes
+ */
+int ConflictMatrix::addClass() {
+    size_t classes = rows.size() + 1;
+    if ((classes + 63) / 64 > words) {
+        words = (classes + 63) / 64;
+        for (Row &row : rows)
+            row.resize(words, 0);
+    }
+    rows.emplace_back(words, 0);
+    return (int) rows.size() - 1;
+}
+
+/**
+ * @brief Marks two Classes as conflicting, in both rows
+ * @param class1
+ * @param class2
+ */
+void ConflictMatrix::set(int class1, int class2) {
+    rows[class1][class2 / 64] |= (uint64_t) 1 << (class2 % 64);
+    rows[class2][class1 / 64] |= (uint64_t) 1 << (class1 % 64);
+}
+
+/**
+ * @brief Marks two Classes as not conflicting, in both rows
+ * @param class1
+ * @param class2
+ */
+void ConflictMatrix::reset(int class1, int class2) {
+    rows[class1][class2 / 64] &= ~((uint64_t) 1 << (class2 % 64));
+    rows[class2][class1 / 64] &= ~((uint64_t) 1 << (class1 % 64));
+}
+
+/**
+ * @brief Adds a Lecture of a Class. Only the row of the Class and its bit in the rows of the Classes it now conflicts
+ * with change, theoric Lectures change nothing.
+ * @param class_ index of the Class
+ * @param lecture
+ * @details Time Complexity O(d) d = number of not theoric lectures on the same weekday
+ */
+void ConflictMatrix::addLecture(int class_, const Lecture &lecture) {
+    if (lecture.getType() == "T" || lecture.getWeekday() < 0 || lecture.getWeekday() >= Timeslots::DAYS)
+        return;
+    std::vector<Interval> &day = practicalByDay[lecture.getWeekday()];
+    day.push_back({lecture.getStartHour(), lecture.getEndHour(), class_});
+    // Same rule as Lecture::overlaps, the new Lecture overlaps itself
+    for (const Interval &other : day) {
+        if (!(lecture.getStartHour() >= other.endHour || lecture.getEndHour() <= other.startHour))
+            set(class_, other.class_);
+    }
+}
+
+/**
+ * @brief Removes a Lecture of a Class. The Class stops conflicting with every Class, and then conflicts again with the
+ * ones that overlap its remaining not theoric Lectures, the rows of the other Classes only change in the bit of this one.
+ * @param class_ index of the Class
+ * @param lecture
+ * @details Time Complexity O(n + p + k * d) n = number of Classes, p = number of not theoric lectures, k = number of not
+ * theoric lectures of the Class, d = number of not theoric lectures on the same weekday
+ */
+void ConflictMatrix::removeLecture(int class_, const Lecture &lecture) {
+    if (lecture.getType() == "T" || lecture.getWeekday() < 0 || lecture.getWeekday() >= Timeslots::DAYS)
+        return;
+    std::vector<Interval> &day = practicalByDay[lecture.getWeekday()];
+    for (auto interval = day.begin(); interval != day.end(); interval++) {
+        if (interval->class_ == class_ && interval->startHour == lecture.getStartHour() && interval->endHour == lecture.getEndHour()) {
+            day.erase(interval);
+            break;
+        }
+    }
+    for (int other = 0; other < size(); other++) {
+        if (conflicts(class_, other))
+            reset(class_, other);
+    }
+    for (const std::vector<Interval> &intervals : practicalByDay) {
+        for (const Interval &own : intervals) {
+            if (own.class_ != class_)
+                continue;
+            for (const Interval &other : intervals) {
+                if (!(own.startHour >= other.endHour || own.endHour <= other.startHour))
+                    set(class_, other.class_);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Checks if two Classes have overlapping not theoric Lectures
+ * @param class1
+ * @param class2
+ * @details Time Complexity O(1)
+ */
+bool ConflictMatrix::conflicts(int class1, int class2) const {
+    return contains(rows[class1], class2);
+}
+
+/**
+ * @brief Checks if a Class conflicts with any of some Classes, e.g. the Classes of a Student
+ * @param class_
+ * @param classes
+ * @details Time Complexity O(k) k = number of classes, one bit of the row of class_ is tested for each
+ */
+bool ConflictMatrix::conflictsWithAny(int class_, const std::vector<int> &classes) const {
+    for (int other : classes) {
+        if (conflicts(class_, other))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the Classes that conflict with any of some Classes, the rows of the Classes joined a word at a time. Useful
+ * to test many Classes against the same Student.
+ * @param classes
+ * @return Classes conflicting with at least one of classes
+ * @details Time Complexity O(k * n / 64) k = number of classes, n = number of Classes of the matrix
+ */
+ConflictMatrix::Row ConflictMatrix::getConflicts(const std::vector<int> &classes) const {
+    Row conflicting(words, 0);
+    for (int class_ : classes) {
+        for (size_t word = 0; word < words; word++)
+            conflicting[word] |= rows[class_][word];
+    }
+    return conflicting;
+}
+
+/**
+ * @brief Checks if a set of Classes contains a Class
+ * @param row
+ * @param class_
+ */
+bool ConflictMatrix::contains(const Row &row, int class_) {
+    return (row[class_ / 64] >> (class_ % 64)) & 1;
+}
+
+/**
+ * @brief Gets the number of Classes
+ */
+int ConflictMatrix::size() const {
+    return (int) rows.size();
+}
@@ -0,0 +1,52 @@
+#ifndef PROJETO_CONFLICTMATRIX_H
+#define PROJETO_CONFLICTMATRIX_H
+
+#include <cstdint>
+#include <vector>
+#include "Lecture.h"
+#include "Timeslots.h"
+
+/**
+ * @brief ConflictMatrix keeps, for every Class of the Course, the set of Classes with a not theoric Lecture that overlaps
+ * one of its own not theoric Lectures. Each row is a bitset over the Classes, so checking a Class against the Classes of
+ * a Student doesn't look at any Lecture. A Class with a not theoric Lecture conflicts with itself.
+ * @note Classes are identified by their index, in the order they were added. The rows only change when a Lecture is added
+ * or removed.
+ */
+
+class ConflictMatrix {
+public:
+    /**
+     * Set of Classes, bit i of word i / 64 is the Class with index i
+     */
+    using Row = std::vector<uint64_t>;
+
+private:
+    /**
+     * Not theoric Lecture of a Class, by weekday
+     */
+    struct Interval {
+        float startHour;
+        float endHour;
+        int class_;
+    };
+    std::vector<Row> rows;
+    std::vector<Interval> practicalByDay[Timeslots::DAYS];
+    size_t words = 0;
+
+    void set(int class1, int class2);
+    void reset(int class1, int class2);
+
+public:
+    int addClass();
+    void addLecture(int class_, const Lecture &lecture);
+    void removeLecture(int class_, const Lecture &lecture);
+    bool conflicts(int class1, int class2) const;
+    bool conflictsWithAny(int class_, const std::vector<int> &classes) const;
+    Row getConflicts(const std::vector<int> &classes) const;
+    static bool contains(const Row &row, int class_);
+    int size() const;
+};
+
+
+#endif //PROJETO_CONFLICTMATRIX_H
@@ -1,20 +1,68 @@
 #include <iostream>
 #include <algorithm>
+#include <unordered_map>
 #include "Course.h"
-#include <sstream>
+#include "Metrics.h"
+#include "ClassAssignment.h"
+#include "SwapCycles.h"
 
 /**
  * @brief Constructor of Course
  */
-Course::Course() { name = "LEIC";}
+Course::Course() : lecturesBySlot(Timeslots::SLOTS), studentsBySlot(Timeslots::SLOTS, 0), timetableVersion(0) { name = "LEIC";}
 
 Course::~Course(){}
 
+/**
+ * @brief Makes a deep copy of the Course, e.g. a snapshot that readers use while this one keeps changing. The copy has
+ * its own Students, its Classes point to them and its index of lectures by slot points to its own Lectures and Classes.
+ * @return copy
+ * @details Time Complexity O(n + l) n = number of students in Classes, l = number of entries of lecturesBySlot
+ */
+std::unique_ptr<Course> Course::clone() const {
+    std::unique_ptr<Course> copy = std::make_unique<Course>();
+    copy->name = name;
+    std::unordered_map<const Student*, Student*> studentCopies;
+    studentCopies.reserve(students.size());
+    for (const auto &[code, student] : students) {
+        auto studentCopy = copy->students.emplace_hint(copy->students.end(), code, std::make_unique<Student>(*student));
+        studentCopies[student.get()] = studentCopy->second.get();
+    }
+    for (const UC &uc : UCs) {
+        UC ucCopy = uc;
+        ucCopy.relinkStudents(studentCopies);
+        copy->UCs.emplace_hint(copy->UCs.end(), std::move(ucCopy));
+    }
+
+    // The sets are equal, so walking both at once pairs each Lecture and Class with its copy
+    std::unordered_map<const Lecture*, const Lecture*> lectureCopies;
+    std::unordered_map<const Class*, const Class*> classCopies;
+    for (auto uc = UCs.begin(), ucCopy = copy->UCs.begin(); uc != UCs.end(); uc++, ucCopy++) {
+        for (auto class_ = uc->getClasses().begin(), classCopy = ucCopy->getClasses().begin(); class_ != uc->getClasses().end(); class_++, classCopy++) {
+            classCopies[&*class_] = &*classCopy;
+            const std::set<Lecture> &lectures = class_->getSchedule().getLectures();
+            auto lectureCopy = classCopy->getSchedule().getLectures().begin();
+            for (auto lecture = lectures.begin(); lecture != lectures.end(); lecture++, lectureCopy++)
+                lectureCopies[&*lecture] = &*lectureCopy;
+        }
+    }
+    for (int slot = 0; slot < Timeslots::SLOTS; slot++) {
+        copy->lecturesBySlot[slot].reserve(lecturesBySlot[slot].size());
+        for (const auto &[lecture, class_] : lecturesBySlot[slot])
+            copy->lecturesBySlot[slot].emplace_back(lectureCopies.at(lecture), classCopies.at(class_));
+    }
+    copy->studentsBySlot = studentsBySlot;
+    copy->freedSeats = freedSeats;
+    copy->conflicts = conflicts;
+    copy->timetableVersion = timetableVersion;
+    return copy;
+}
+
 /**
  * @brief Get Course name
  * @return name
  */
-std::string Course::getName() const { return name;}
+const std::string& Course::getName() const { return name;}
 
 /**
  * @brief Adds UC to the Course
@@ -22,25 +70,23 @@ std::string Course::getName() const { return name;}
  * @details Time Complexity O(log n) n = number of UC's
  */
 void Course::addUC(std::string ucCode) {
-    UC newUC(ucCode);
-    UCs.insert(newUC);
+    UCs.insert(UC(std::move(ucCode)));
 }
 
 /**
- * @brief Adds a Class to the Course
+ * @brief Adds a Class to the Course, with the next index of the conflict matrix
  * @param classCode
  * @param ucCode
- * @details Time Complexity O(n) n= number of UC's
+ * @note The UC is taken out of the set and put back without being copied
+ * @details Time Complexity O(log n + c) n= number of UC's, c = number of Classes of the Course (amortized)
  */
 void Course::addClass(std::string classCode, std::string ucCode) {
-    for (UC uc : UCs) {
-        if (uc.getUcCode() == ucCode) {
-            UCs.erase(uc);
-            uc.addClass(Class(classCode, ucCode));
-            UCs.insert(uc);
-            return;
-        }
-    }
+    auto node = UCs.extract(UC(ucCode));
+    if (node.empty())
+        return;
+    if (node.value().getClasses().count(Class(classCode, ucCode)) == 0)
+        node.value().addClass(Class(std::move(classCode), std::move(ucCode), conflicts.addClass()));
+    UCs.insert(std::move(node));
 }
 
 /**
@@ -49,68 +95,162 @@ void Course::addClass(std::string classCode, std::string ucCode) {
  * @param studentName
  * @param ucCode
  * @param classCode
- * @details Time Complexity O(n) = number of UC's
+ * @return false if the UC or the Class doesn't exist, the Student is created anyway
+ * @note The Student is created only the first time its code appears, the Course keeps ownership of it
+ * @details Time Complexity O(log n + log m) n = number of students, m = number of UC's
  */
-void Course::addStudent(std::string studentCode, std::string studentName, std::string ucCode, std::string classCode) {
-    Student* newStudent = new Student(studentCode, studentName);
-    auto student = students.find(newStudent);
+bool Course::addStudent(std::string studentCode, std::string studentName, const std::string &ucCode, const std::string &classCode) {
+    auto student = students.find(studentCode);
     // Not in course
     if (student == students.end()) {
-        students.insert(newStudent);
-        for (UC uc : UCs) {
-            if (uc.getUcCode() == ucCode) {
-                UCs.erase(uc);
-                uc.addStudent(newStudent, classCode);
-                UCs.insert(uc);
-                return;
-            }
-        }
+        auto newStudent = std::make_unique<Student>(std::move(studentCode), std::move(studentName));
+        const std::string &code = newStudent->getStudentCode();
+        student = students.emplace(code, std::move(newStudent)).first;
     }
-    // In course
-    else {
-        delete newStudent;
-        for (UC uc: UCs) {
-            if (uc.getUcCode() == ucCode) {
-                UCs.erase(uc);
-                uc.addStudent(*student, classCode);
-                UCs.insert(uc);
-                return;
-            }
+    auto node = UCs.extract(UC(ucCode));
+    if (node.empty())
+        return false;
+    bool isClass = node.value().getClasses().count(Class(classCode, ucCode)) > 0;
+    Timeslots::Mask busyBefore = student->second->getSchedule().getBusySlots();
+    node.value().addStudent(student->second.get(), classCode);
+    updateSlotOccupation(busyBefore, student->second->getSchedule().getBusySlots());
+    UCs.insert(std::move(node));
+    return isClass;
+}
+
+/**
+ * @brief Adds Lecture to a UC of the Course, to the slot index and to the conflict matrix
+ * @param classCode
+ * @param ucCode
+ * @param type
+ * @param weekday
+ * @param startHour
+ * @param duration
+ * @return false if the UC or the Class doesn't exist
+ * @details Time Complexity O(log n + s) n = number of UC's, s = number of students of the Class
+ */
+bool Course::addLecture(const std::string &classCode, std::string ucCode, std::string type, const std::string &weekday, float startHour, float duration) {
+    auto node = UCs.extract(UC(ucCode));
+    if (node.empty())
+        return false;
+    auto class_ = node.value().getClasses().find(Class(classCode, ucCode));
+    if (class_ == node.value().getClasses().end()) {
+        UCs.insert(std::move(node));
+        return false;
+    }
+    Lecture lecture(classCode, ucCode, weekday, startHour, duration, type);
+    bool isNew = class_->getSchedule().getLectures().count(lecture) == 0;
+    std::vector<std::pair<Student*, Timeslots::Mask>> busyBefore;
+    for (Student *student : class_->getStudents())
+        busyBefore.emplace_back(student, student->getSchedule().getBusySlots());
+
+    node.value().addLecture(classCode, std::move(ucCode), std::move(type), weekday, startHour, duration);
+    for (const auto &[student, busy] : busyBefore)
+        updateSlotOccupation(busy, student->getSchedule().getBusySlots());
+    if (isNew) {
+        class_ = node.value().getClasses().find(Class(classCode, node.value().getUcCode()));
+        const Lecture *added = &*class_->getSchedule().getLectures().find(lecture);
+        conflicts.addLecture(class_->getIndex(), *added);
+        timetableVersion++;
+        Timeslots::Mask slots = Timeslots::getLectureSlots(*added);
+        for (int slot = 0; slot < Timeslots::SLOTS; slot++) {
+            if (slots[slot])
+                lecturesBySlot[slot].emplace_back(added, &*class_);
         }
     }
+    UCs.insert(std::move(node));
+    return true;
 }
 
 /**
- * @brief Adds Lecture to a UC of the Course
+ * @brief Removes a Lecture from a UC of the Course, from the slot index and from the conflict matrix, e.g. when the
+ * timetable is fixed while the Course is running
  * @param classCode
  * @param ucCode
  * @param type
  * @param weekday
  * @param startHour
  * @param duration
- * @details Time Complexity O(n) n = number of UC's
+ * @return false if the Class has no such Lecture
+ * @details Time Complexity O(log n + s + c + p) n = number of UC's, s = number of students of the Class, c = number of
+ * Classes (conflict matrix), p = number of Lectures in the slots of the Lecture
  */
-void Course::addLecture(std::string classCode, std::string ucCode, std::string type, std::string weekday, float startHour, float duration) {
-    for (UC uc : UCs) {
-        if (uc.getUcCode() == ucCode) {
-            UCs.erase(uc);
-            uc.addLecture(classCode, ucCode, type, weekday, startHour, duration);
-            UCs.insert(uc);
-            return;
-        }
+bool Course::removeLecture(const std::string &classCode, const std::string &ucCode, const std::string &type, const std::string &weekday, float startHour, float duration) {
+    auto node = UCs.extract(UC(ucCode));
+    if (node.empty())
+        return false;
+    auto class_ = node.value().getClasses().find(Class(classCode, ucCode));
+    if (class_ == node.value().getClasses().end()) {
+        UCs.insert(std::move(node));
+        return false;
+    }
+    auto removed = class_->getSchedule().getLectures().find(Lecture(classCode, ucCode, weekday, startHour, duration, type));
+    if (removed == class_->getSchedule().getLectures().end()) {
+        UCs.insert(std::move(node));
+        return false;
     }
+    // The slot index points to the Lecture, so it is taken out before the Lecture is destroyed
+    Timeslots::Mask slots = Timeslots::getLectureSlots(*removed);
+    for (int slot = 0; slot < Timeslots::SLOTS; slot++) {
+        if (!slots[slot])
+            continue;
+        std::vector<std::pair<const Lecture*, const Class*>> &lectures = lecturesBySlot[slot];
+        lectures.erase(std::remove_if(lectures.begin(), lectures.end(), [&removed](const std::pair<const Lecture*, const Class*> &entry) {
+            return entry.first == &*removed;
+        }), lectures.end());
+    }
+    conflicts.removeLecture(class_->getIndex(), *removed);
+    std::vector<std::pair<Student*, Timeslots::Mask>> busyBefore;
+    for (Student *student : class_->getStudents())
+        busyBefore.emplace_back(student, student->getSchedule().getBusySlots());
+
+    Lecture lecture = *removed;
+    node.value().removeLecture(classCode, lecture);
+    for (const auto &[student, busy] : busyBefore)
+        updateSlotOccupation(busy, student->getSchedule().getBusySlots());
+    timetableVersion++;
+    UCs.insert(std::move(node));
+    return true;
 }
 
 /**
- * @brief Gets the Schedule of a Student from the Course
+ * @brief Removes a Student from a Class of the Course, e.g. when its enrollment is taken out of the data files while
+ * the Course is running. The Student stays in the Course.
  * @param studentCode
- * @details Time Complexity O(n) n= number of students
+ * @param ucCode
+ * @param classCode
+ * @return false if the Student isn't in the Class
+ * @details Time Complexity O(log n + log m + k log l) n = number of students, m = number of UC's, k = number of lectures
+ * of the Class, l = number of lectures of the Student
  */
-Schedule Course::getStudentSchedule(std::string studentCode) const {
-    for (Student* student : students){
-        if (student->getStudentCode() == studentCode)
-            return student->getSchedule();
+bool Course::removeStudent(const std::string &studentCode, const std::string &ucCode, const std::string &classCode) {
+    Student *student = findStudentByCode(studentCode);
+    if (student == nullptr)
+        return false;
+    auto node = UCs.extract(UC(ucCode));
+    if (node.empty())
+        return false;
+    auto class_ = node.value().getClasses().find(Class(classCode, ucCode));
+    bool isIn = class_ != node.value().getClasses().end() && class_->getStudents().count(student) > 0;
+    if (isIn) {
+        Timeslots::Mask busyBefore = student->getSchedule().getBusySlots();
+        node.value().removeStudent(student, classCode);
+        updateSlotOccupation(busyBefore, student->getSchedule().getBusySlots());
     }
+    UCs.insert(std::move(node));
+    return isIn;
+}
+
+/**
+ * @brief Gets the Schedule of a Student from the Course
+ * @param studentCode
+ * @details Time Complexity O(log n) n= number of students
+ */
+Schedule Course::getStudentSchedule(const std::string &studentCode) const {
+    Student *student = findStudentByCode(studentCode);
+    if (student == nullptr)
+        return Schedule();
+    return student->getSchedule();
 }
 
 /**
@@ -119,7 +259,7 @@ Schedule Course::getStudentSchedule(std::string studentCode) const {
  * @return classSchedule
  * @details Time Complexity O(n*m) n= number of UC', m= number of classes per UC
  */
-Schedule Course::getClassSchedule(std::string classCode) const {
+Schedule Course::getClassSchedule(const std::string &classCode) const {
     Schedule classSchedule;
     for (const UC &uc : UCs) {
         for (const Class &class_ : uc.getClasses()) {
@@ -133,13 +273,13 @@ Schedule Course::getClassSchedule(std::string classCode) const {
 /**
  * @brief Gets the Schedule of a certain UC of the Course
  * @param ucCode
- * @details Time Complexity O(n) n = number of UC's
+ * @details Time Complexity O(log n + m) n = number of UC's, m = number of lectures of the UC
  */
-Schedule Course::getUcSchedule(std::string ucCode) const {
-    for (const UC &uc : UCs) {
-        if (uc.getUcCode() == ucCode)
-            return uc.getSchedule();
-    }
+Schedule Course::getUcSchedule(const std::string &ucCode) const {
+    auto uc = UCs.find(UC(ucCode));
+    if (uc == UCs.end())
+        return Schedule();
+    return uc->getSchedule();
 }
 
 /**
@@ -149,8 +289,9 @@ Schedule Course::getUcSchedule(std::string ucCode) const {
  */
 std::vector<Student*> Course::getStudentsInCourse() const {
     std::vector<Student*> studentsInCourse;
-    for (Student* student : students) {
-        studentsInCourse.push_back(student);
+    studentsInCourse.reserve(students.size());
+    for (const auto &student : students) {
+        studentsInCourse.push_back(student.second.get());
     }
     return studentsInCourse;
 }
@@ -160,47 +301,30 @@ std::vector<Student*> Course::getStudentsInCourse() const {
  * @param classCode code of the Class
  * @param ucCode code of the UC of the Class
  * @return studentsVector
- * @details Time Complexity O(n+ m +k log k) n= number of UC's m= number of classes k= number of students
- * @note Time Complexity depends on the case
+ * @details Time Complexity O(log n + log m + k) n= number of UC's m= number of classes k= number of students
  */
-std::vector<Student*> Course::getStudentsInClass(std::string classCode,std::string ucCode) const {
-    std::set<Student*, cmp> studentsInClass;
-    for (const UC &uc : UCs) {
-        if (uc.getUcCode() == ucCode) {
-            for (const Class &class_ : uc.getClasses()) {
-                if (class_.getClassCode() == classCode) {
-                    for (Student* student : class_.getStudents())
-                        studentsInClass.insert(student);
-                }
-            }
-        }
-    }
-    std::vector<Student*> studentsVector;
-    for (Student *student : studentsInClass) {
-        studentsVector.push_back(student);
-    }
-    return studentsVector;
+std::vector<Student*> Course::getStudentsInClass(const std::string &classCode, const std::string &ucCode) const {
+    auto uc = UCs.find(UC(ucCode));
+    if (uc == UCs.end())
+        return {};
+    auto class_ = uc->getClasses().find(Class(classCode, ucCode));
+    if (class_ == uc->getClasses().end())
+        return {};
+    return std::vector<Student*>(class_->getStudents().begin(), class_->getStudents().end());
 }
 
 /**
  * @brief Gets the Students registered in a certain UC
  * @param ucCode
  * @return studentsVector
- * @details Time Complexity O(m log m) m= number of students
+ * @details Time Complexity O(log n + m log m) n= number of UC's m= number of students
  */
-std::vector<Student*> Course::getStudentsInUC(std::string ucCode) const {
-    std::set<Student*, cmp> studentsInUC;
-    for (const UC &uc : UCs) {
-        if (uc.getUcCode() == ucCode) {
-            for (Student* student : uc.getStudents())
-                studentsInUC.insert(student);
-        }
-    }
-    std::vector<Student*> studentsVector;
-    for (Student *student : studentsInUC) {
-        studentsVector.push_back(student);
-    }
-    return studentsVector;
+std::vector<Student*> Course::getStudentsInUC(const std::string &ucCode) const {
+    auto uc = UCs.find(UC(ucCode));
+    if (uc == UCs.end())
+        return {};
+    std::set<Student*, cmp> studentsInUC = uc->getStudents();
+    return std::vector<Student*>(studentsInUC.begin(), studentsInUC.end());
 }
 
 /**
@@ -210,8 +334,8 @@ std::vector<Student*> Course::getStudentsInUC(std::string ucCode) const {
  * @details Time Complexity O(n * (m + k log k)) n = number of UC's m= number of classes k = number of students
  * @note Time Complexity depends on the case
  */
-std::vector<Student*> Course::getStudentsInYear(std::string year) const {
-    std::set<Student*> studentsInYear;
+std::vector<Student*> Course::getStudentsInYear(const std::string &year) const {
+    std::set<Student*, cmp> studentsInYear;
     for (const UC &uc : UCs) {
         for (const Class &class_ : uc.getClasses()) {
             if (class_.getYear() == year) {
@@ -236,9 +360,9 @@ std::vector<Student*> Course::getStudentsInYear(std::string year) const {
  */
 std::vector<Student*> Course::getStudentsInAtLeastUCs(int n) const {
     std::vector<Student*> studentsInAtLeastUcs;
-    for (Student* student : getStudentsInCourse()) {
-        if (student->getNumberUcs() >= n) {
-            studentsInAtLeastUcs.push_back(student);
+    for (const auto &student : students) {
+        if (student.second->getNumberUcs() >= n) {
+            studentsInAtLeastUcs.push_back(student.second.get());
         }
     }
     return studentsInAtLeastUcs;
@@ -250,7 +374,7 @@ std::vector<Student*> Course::getStudentsInAtLeastUCs(int n) const {
  * @return UCsInYear
  * @details Time Complexity O(n) n= number of UC's
  */
-std::vector<UC> Course::getUCsInYear(std::string year) const {
+std::vector<UC> Course::getUCsInYear(const std::string &year) const {
     std::vector<UC> UCsInYear;
     for (const UC &uc : UCs) {
         if (uc.getYear() == year)
@@ -263,19 +387,13 @@ std::vector<UC> Course::getUCsInYear(std::string year) const {
  * @brief Gets the Classes of a certain UC
  * @param ucCode
  * @return classesInUc
- * @details Time Complexity O(n + m) n= number of UC's m= number of Classes
- * @note Time Complexity depends on the case
+ * @details Time Complexity O(log n + m) n= number of UC's m= number of Classes
  */
-std::vector<Class> Course::getClassesInUC(std::string ucCode) const {
-    std::vector<Class> classesInUC;
-    for (const UC &uc : UCs) {
-        if (uc.getUcCode() == ucCode) {
-            for (const Class &class_ : uc.getClasses()) {
-                classesInUC.push_back(class_);
-            }
-            return classesInUC;
-        }
-    }
+std::vector<Class> Course::getClassesInUC(const std::string &ucCode) const {
+    auto uc = UCs.find(UC(ucCode));
+    if (uc == UCs.end())
+        return {};
+    return std::vector<Class>(uc->getClasses().begin(), uc->getClasses().end());
 }
 
 /**
@@ -294,6 +412,20 @@ std::vector<Class> Course::getClasses() const {
     return classes;
 }
 
+/**
+ * @brief Gets the Classes of the Course in the order they were added (by index), without copying them
+ * @return pointers to the Classes, valid until the Course changes
+ * @details Time Complexity O(c) c = number of Classes
+ */
+std::vector<const Class*> Course::getClassesByIndex() const {
+    std::vector<const Class*> classes(conflicts.size(), nullptr);
+    for (const UC &uc : UCs) {
+        for (const Class &class_ : uc.getClasses())
+            classes[class_.getIndex()] = &class_;
+    }
+    return classes;
+}
+
 /**
  * @brief Gets the UC's of the Course
  * @return ucs
@@ -307,21 +439,131 @@ std::vector<UC> Course::getUCs() const {
     return ucs;
 }
 
+/**
+ * @brief Gets the UC's of the Course sorted by code, without copying them
+ * @return reference to the UC's, valid until the Course changes
+ * @details Time Complexity O(1)
+ */
+const std::set<UC>& Course::getUCsByCode() const {
+    return UCs;
+}
+
 /**
  * @brief Gets the Classes of a certain Student
  * @param studentCode
  * @return classes
- * @details Time Complexity O(n *(m+k)) n= number of lectures m = number of UC's k= number of Classes on a UC
+ * @details Time Complexity O(n *(log m + log k)) n= number of lectures m = number of UC's k= number of Classes on a UC
  */
-std::set<Class> Course::getStudentClasses(std::string studentCode) const {
+std::set<Class> Course::getStudentClasses(const std::string &studentCode) const {
     Student *student = findStudentByCode(studentCode);
     std::set<Class> classes;
-    for (Lecture lecture : student->getSchedule().getLectures()) {
+    if (student == nullptr)
+        return classes;
+    for (const Lecture &lecture : student->getSchedule().getLectures()) {
         classes.insert(findClassByCode(lecture.getClass(), lecture.getUC()));
     }
     return classes;
 }
 
+/**
+ * @brief Gets the half-hour slots in which every student of a group is free. The busy slots of the students are joined
+ * a machine word at a time, stopping as soon as no slot is left.
+ * @param students
+ * @return slots free for every student
+ * @details Time Complexity O(n * w) n = number of students, w = number of machine words of a Timeslots::Mask
+ */
+Timeslots::Mask Course::getCommonFreeSlots(const std::vector<Student*> &students) const {
+    Timeslots::Mask busy;
+    for (const Student *student : students) {
+        busy |= student->getSchedule().getBusySlots();
+        if (busy.all())
+            break;
+    }
+    return ~busy;
+}
+
+/**
+ * @brief Gets, for each half-hour slot, how many students of a group are free. The busy students are counted with a
+ * bit-sliced counter: plane p holds bit p of the count of every slot, and each student is added with a binary increment
+ * carried through the planes with word-wide AND/XOR, so the counts of all slots are updated at once.
+ * @param students
+ * @return number of free students of each slot
+ * @details Time Complexity O(n * w * log n) n = number of students, w = number of machine words of a Timeslots::Mask
+ */
+std::vector<int> Course::getSlotAvailability(const std::vector<Student*> &students) const {
+    std::vector<Timeslots::Mask> planes;
+    for (const Student *student : students) {
+        Timeslots::Mask carry = student->getSchedule().getBusySlots();
+        for (size_t plane = 0; carry.any(); plane++) {
+            if (plane == planes.size()) {
+                planes.push_back(carry);
+                break;
+            }
+            Timeslots::Mask next = planes[plane] & carry;
+            planes[plane] ^= carry;
+            carry = next;
+        }
+    }
+    std::vector<int> available(Timeslots::SLOTS, (int) students.size());
+    for (size_t plane = 0; plane < planes.size(); plane++) {
+        for (int slot = 0; slot < Timeslots::SLOTS; slot++) {
+            if (planes[plane][slot])
+                available[slot] -= 1 << plane;
+        }
+    }
+    return available;
+}
+
+/**
+ * @brief Gets the Lectures in session at a time of the week, each with its Class (its students are attending it)
+ * @param weekday
+ * @param hour
+ * @return Lectures occurring during the half hour that contains the hour
+ * @details Time Complexity O(1), the Lectures of each half hour are indexed as they are added
+ */
+const std::vector<std::pair<const Lecture*, const Class*>>& Course::getLecturesAt(int weekday, float hour) const {
+    static const std::vector<std::pair<const Lecture*, const Class*>> none;
+    if (weekday < 0 || weekday >= Timeslots::DAYS)
+        return none;
+    return lecturesBySlot[Timeslots::getSlot(weekday, hour)];
+}
+
+/**
+ * @brief Gets the number of different students in session at a time of the week
+ * @param weekday
+ * @param hour
+ * @return students with a Lecture during the half hour that contains the hour
+ * @details Time Complexity O(1), the counts are kept up to date as students join and leave Classes
+ */
+int Course::getStudentsInSessionAt(int weekday, float hour) const {
+    if (weekday < 0 || weekday >= Timeslots::DAYS)
+        return 0;
+    return studentsBySlot[Timeslots::getSlot(weekday, hour)];
+}
+
+/**
+ * @brief Gets the version of the timetables of the Course, it changes every time a Lecture is added
+ */
+unsigned long Course::getTimetableVersion() const {
+    return timetableVersion;
+}
+
+/**
+ * @brief Updates the number of students in session in each slot after the Schedule of a Student changed
+ * @param before busy slots of the Student before the change
+ * @param after busy slots of the Student after the change
+ * @details Time Complexity O(s) s = number of slots of the week, constant
+ */
+void Course::updateSlotOccupation(const Timeslots::Mask &before, const Timeslots::Mask &after) {
+    Timeslots::Mask changed = before ^ after;
+    if (changed.none())
+        return;
+    for (int slot = 0; slot < Timeslots::SLOTS; slot++) {
+        if (changed[slot])
+            studentsBySlot[slot] += after[slot] ? 1 : -1;
+    }
+}
+
 /**
  * @brief Gets the occupation of all years of the Course
  * @return yearOccupation
@@ -353,85 +595,157 @@ int Course::getOccupation() const {
 /**
  * @brief Assesses a Request, if it doesn't violates any rule,the Request is done
  * @param request
- * @details Time Complexity O(n log n + m *k) n= number of classes (checkUcBalance), m= number of not theoric lectures of Student k= number of lectures of Class (checkScheduleConflicts)
+ * @note The UC's being changed are taken out of the set and put back without being copied. The seats freed are kept
+ * until takeFreedSeats is called.
+ * @details Time Complexity O(log n + c * k) n= number of UC's, c= number of classes tried (chooseClassFromUC), k= number of classes of Student (checkScheduleConflicts)
  */
 bool Course::assessRequest(Request *request) {
+    bool accepted = tryRequest(request);
+    if (!accepted)
+        METRICS_REJECTION(request->getRejection());
+    return accepted;
+}
+
+/**
+ * @brief Assesses a Request like assessRequest, without counting its rejection, e.g. for a batch where it may still be
+ * accepted later
+ * @param request
+ * @details Time Complexity O(log n + c * k), see assessRequest
+ */
+bool Course::tryRequest(Request *request) {
+    request->accept();      // Clears the reason of a previous rejection, e.g. of a request that was waiting
     Student *student = findStudentByCode(request->getStudentCode()); //log n
+    if (student == nullptr) {
+        request->reject(Request::STUDENT_NOT_FOUND);
+        return false;
+    }
+    Timeslots::Mask busyBefore = student->getSchedule().getBusySlots();
+    bool accepted = assessStudentRequest(student, request);
+    updateSlotOccupation(busyBefore, student->getSchedule().getBusySlots());
+    return accepted;
+}
 
+/**
+ * @brief Assesses a Request of a Student of the Course, if it doesn't violates any rule, the Request is done
+ * @param student Student that made the request
+ * @param request
+ * @details Time Complexity O(log n + c * k), see assessRequest
+ */
+bool Course::assessStudentRequest(Student *student, Request *request) {
     if (JoinRequest* joinReq = dynamic_cast<JoinRequest*>(request)) {
-        UC uc = findUcByCode(joinReq->getUcCode()); //n
+        METRICS_TIMER(ASSESS_JOIN);
+        auto ucNode = UCs.extract(UC(joinReq->getUcCode())); //log n
+        if (ucNode.empty()) {
+            request->reject(Request::UC_NOT_FOUND, joinReq->getUcCode());
+            return false;
+        }
+        UC &uc = ucNode.value();
+        bool accepted = false;
         if (checkNumberUCs(student, request)) {
-            bool found;
-            Class class_ = chooseClassFromUC(student, uc, request, found);
-            if (found) {
-                UCs.erase(uc);
-                uc.removeClass(class_);
-                class_.addStudent(student);
-                uc.addClass(class_);
-                UCs.insert(uc);
-                return true;
+            const Class *class_ = nullptr;
+            if (joinReq->getClassCode().empty())
+                class_ = chooseClassFromUC(student, uc, request);
+            else {
+                // Class given, e.g. replaying a request whose Class was chosen by assessJoinBatch
+                auto chosen = uc.getClasses().find(Class(joinReq->getClassCode(), uc.getUcCode()));
+                if (chosen == uc.getClasses().end())
+                    request->reject(Request::CLASS_NOT_FOUND, uc.getUcCode(), joinReq->getClassCode());
+                else if (checkClassCap(*chosen, request) && checkScheduleConflicts(student, *chosen, request))
+                    class_ = &*chosen;
+            }
+            if (class_ != nullptr) {
+                joinReq->setClassCode(class_->getClassCode());
+                uc.addStudent(student, joinReq->getClassCode());
+                accepted = true;
             }
         }
+        UCs.insert(std::move(ucNode));
+        return accepted;
     }
     else if (LeaveRequest* leaveReq = dynamic_cast<LeaveRequest*>(request)) {
-        UC uc = findUcByCode(leaveReq->getUcCode());
-        UCs.erase(uc);
-        uc.removeStudent(student);
-        UCs.insert(uc);
+        METRICS_TIMER(ASSESS_LEAVE);
+        auto ucNode = UCs.extract(UC(leaveReq->getUcCode()));
+        if (ucNode.empty()) {
+            request->reject(Request::UC_NOT_FOUND, leaveReq->getUcCode());
+            return false;
+        }
+        std::string classCode = ucNode.value().removeStudent(student);
+        if (!classCode.empty())
+            freedSeats.emplace_back(ucNode.value().getUcCode(), std::move(classCode));
+        UCs.insert(std::move(ucNode));
         return true;
     }
     else if (SwitchUcRequest* switchUcReq = dynamic_cast<SwitchUcRequest*>(request)) {
-        UC currentUC = findUcByCode(switchUcReq->getUcCodeCurrent());
-        UC nextUC = findUcByCode(switchUcReq->getUcCodeNext());
-        bool found;
-        for (const Lecture &lecture : student->getSchedule().getLectures()) {
-            if (lecture.getUC() == currentUC.getUcCode())
-                student->removeLecture(lecture);
-        }
-        Class class_ = chooseClassFromUC(student, nextUC, request, found);
-        if (found) {
+        METRICS_TIMER(ASSESS_SWITCH_UC);
+        auto currentUC = UCs.find(UC(switchUcReq->getUcCodeCurrent()));
+        auto nextUC = UCs.find(UC(switchUcReq->getUcCodeNext()));
+        if (currentUC == UCs.end() || nextUC == UCs.end() || currentUC == nextUC) {
+            request->reject(Request::INVALID_UC_SWITCH, switchUcReq->getUcCodeCurrent(), "", switchUcReq->getUcCodeNext());
+            return false;
+        }
+        // The classes of the current UC don't count while choosing a class of the next UC
+        std::vector<int> currentClasses;
+        for (const Class &currentClass : currentUC->getClasses()) {
+            if (currentClass.getStudents().count(student) > 0 && student->leaveClass(currentClass.getIndex()))
+                currentClasses.push_back(currentClass.getIndex());
+        }
+        // e.g. a switch that waited while the Student left the UC
+        if (currentClasses.empty()) {
+            request->reject(Request::NOT_ENROLLED, switchUcReq->getUcCodeCurrent());
+            return false;
+        }
+
+        auto nextNode = UCs.extract(nextUC);
+        const Class *class_ = chooseClassFromUC(student, nextNode.value(), request);
+        for (int index : currentClasses)
+            student->joinClass(index);
+        if (class_ != nullptr) {
             // Remove from current UC
-            UCs.erase(currentUC);
-            currentUC.removeStudent(student);
-            UCs.insert(currentUC);
+            auto currentNode = UCs.extract(currentUC);
+            std::string classCode = currentNode.value().removeStudent(student);
+            if (!classCode.empty())
+                freedSeats.emplace_back(currentNode.value().getUcCode(), std::move(classCode));
+            UCs.insert(std::move(currentNode));
             // Add to a class in the next UC
-            UCs.erase(nextUC);
-            nextUC.removeClass(class_);
-            class_.addStudent(student);
-            nextUC.addClass(class_);
-            UCs.insert(nextUC);
+            nextNode.value().addStudent(student, class_->getClassCode());
+            UCs.insert(std::move(nextNode));
             return true;
         }
-        for (const Lecture &lecture : student->getSchedule().getLectures()) {
-            if (lecture.getUC() == currentUC.getUcCode())
-                student->addLecture(lecture);
-        }
+        UCs.insert(std::move(nextNode));
     }
     else if (SwitchClassRequest* switchClassReq = dynamic_cast<SwitchClassRequest*>(request)) {
-        Class currentClass = findClassByCode(switchClassReq->getClassCodeCurrent(), switchClassReq->getUcCode());
-        Class nextClass = findClassByCode(switchClassReq->getClassCodeNext(), switchClassReq->getUcCode());
-        UC uc = findUcByCode(switchClassReq->getUcCode());
-        for (const Lecture &lecture : currentClass.getSchedule().getLectures()) {
-            student->removeLecture(lecture);
-        }
-        if (canChooseClass(student, uc, currentClass, nextClass, request)) {
-            // Remove student from current class
-            UCs.erase(uc);
-            uc.removeClass(currentClass);
-            currentClass.removeStudent(student);
-            uc.addClass(currentClass);
-            UCs.insert(uc);
-            // Add student to next Class
-            UCs.erase(uc);
-            uc.removeClass(nextClass);
-            nextClass.addStudent(student);
-            uc.addClass(nextClass);
-            UCs.insert(uc);
-            return true;
+        METRICS_TIMER(ASSESS_SWITCH_CLASS);
+        auto ucNode = UCs.extract(UC(switchClassReq->getUcCode()));
+        if (ucNode.empty()) {
+            request->reject(Request::UC_NOT_FOUND, switchClassReq->getUcCode());
+            return false;
+        }
+        UC &uc = ucNode.value();
+        auto currentClass = uc.getClasses().find(Class(switchClassReq->getClassCodeCurrent(), uc.getUcCode()));
+        auto nextClass = uc.getClasses().find(Class(switchClassReq->getClassCodeNext(), uc.getUcCode()));
+        if (currentClass == uc.getClasses().end() || nextClass == uc.getClasses().end()) {
+            request->reject(Request::INVALID_CLASS_SWITCH, uc.getUcCode(), switchClassReq->getClassCodeCurrent(), switchClassReq->getClassCodeNext());
+            UCs.insert(std::move(ucNode));
+            return false;
         }
-        for (const Lecture &lecture : currentClass.getSchedule().getLectures()) {
-            student->addLecture(lecture);
+        // The current class doesn't count while checking the schedule of the next one
+        bool wasInCurrent = currentClass->getStudents().count(student) > 0 && student->leaveClass(currentClass->getIndex());
+        if (!wasInCurrent) {
+            // e.g. a switch that waited while the Student moved to another Class, it would end up in two
+            request->reject(Request::NOT_ENROLLED, uc.getUcCode(), switchClassReq->getClassCodeCurrent());
+            UCs.insert(std::move(ucNode));
+            return false;
         }
+        bool accepted = canChooseClass(student, uc, *currentClass, *nextClass, request);
+        student->joinClass(currentClass->getIndex());
+        if (accepted) {
+            // Remove student from current class and add it to next Class, freeing a seat of the current one
+            uc.removeStudent(student, switchClassReq->getClassCodeCurrent());
+            uc.addStudent(student, switchClassReq->getClassCodeNext());
+            freedSeats.emplace_back(uc.getUcCode(), switchClassReq->getClassCodeCurrent());
+        }
+        UCs.insert(std::move(ucNode));
+        return accepted;
     }
     return false;
 }
@@ -439,83 +753,69 @@ bool Course::assessRequest(Request *request) {
 /**
  * @brief Gets a Student of the Course by its code
  * @param studentCode
- * @return currentStudent
- * @note Finding Student using BinarySearch
+ * @return Student with that code, nullptr if there is none
  * @details Time Complexity O(log n) n= number of students
  */
-Student* Course::findStudentByCode(std::string studentCode) const {
-    //BINARY SEARCH
-    auto left = students.begin();
-    auto right =students.end();
-
-    while (left != right) {
-        auto mid=left;
-        std::advance(mid,std::distance(left,right)/2);
-        Student* currentStudent = *mid;
-
-        if (currentStudent->getStudentCode() == studentCode) {
-            return currentStudent;
-        } else if (currentStudent->getStudentCode() < studentCode) {
-            left = mid++;
-        } else {
-            right = mid--;
-        }
-    }
-    return *left;
+Student* Course::findStudentByCode(const std::string &studentCode) const {
+    auto student = students.find(studentCode);
+    if (student == students.end())
+        return nullptr;
+    return student->second.get();
 }
 
 /**
  * @brief Gets a UC of the Course using its code
  * @param ucCode
- * @return uc
- * @details Time Complexity O(n) n= number of UC's
+ * @return uc, a UC without classes if there is none with that code
+ * @details Time Complexity O(log n) n= number of UC's
  */
-UC Course::findUcByCode(std::string ucCode) const {
-    for(UC uc : UCs){
-        if (uc.getUcCode() == ucCode)
-            return uc;
-    }
+UC Course::findUcByCode(const std::string &ucCode) const {
+    auto uc = UCs.find(UC(ucCode));
+    if (uc == UCs.end())
+        return UC(ucCode);
+    return *uc;
 }
 
 /**
  * @brief Gets a Class of the Course using its code
  * @param classCode
  * @param ucCode
- * @return class_
- * @details Time Complexity O(n + m) n = number of UC's m= number of Classes
- */
-Class Course::findClassByCode(std::string classCode, std::string ucCode) const {
-    for(UC uc : UCs){
-        if (uc.getUcCode() == ucCode) {
-            for (Class class_: uc.getClasses()) {
-                if (class_.getClassCode() == classCode) return class_;
-            }
-        }
+ * @return class_, a Class without students if there is none with that code
+ * @details Time Complexity O(log n + log m) n = number of UC's m= number of Classes
+ */
+Class Course::findClassByCode(const std::string &classCode, const std::string &ucCode) const {
+    auto uc = UCs.find(UC(ucCode));
+    if (uc != UCs.end()) {
+        auto class_ = uc->getClasses().find(Class(classCode, ucCode));
+        if (class_ != uc->getClasses().end())
+            return *class_;
     }
+    return Class(classCode, ucCode);
 }
 
 /**
- * @brief Chooses the best Class for a Student, following a Request
+ * @brief Chooses the best Class for a Student, following a Request: the least occupied Class that fits the Student
  * @param student Student who requested
  * @param uc UC to join/switch
- * @param request Request
- * @param found check if Class was found for the Student
- * @details Time Complexity O(n log n + m *k) n= number of classes (sort), n= number of not theoric lectures of Student m= number of lectures of Class (CheckScheduleConflicts)
+ * @param request Request, rejected with the reason of the last Class tried if none fits, accepted if one does
+ * @return class_, nullptr if no Class fits the Student
+ * @note The Classes are visited by occupation through the index kept by the UC, so nothing is copied or sorted and the
+ * search stops at the first Class that fits, or at the first full one since all the others are at least as full
+ * @details Time Complexity O(c * (log n + k)) c = number of classes tried, n = number of classes of the UC, k = number of classes of Student (checkScheduleConflicts)
  */
-Class Course::chooseClassFromUC(Student *student, UC &uc, Request *request, bool &found) {
-    std::set<Class> classesSet = uc.getClasses();
-    std::vector<Class> classes;
-    for (Class class_ : classesSet) {
-        classes.push_back(class_);
-    }
-    std::sort(classes.begin(), classes.end(), [](Class class1, Class class2) {return ( class1.getOccupation() < class2.getOccupation()); });
-    for (const Class &class_ : classes) {
-        if (checkScheduleConflicts(student, class_, request) && checkClassCap(class_, request))
-            found = true;
-        return class_;
+const Class* Course::chooseClassFromUC(const Student *student, const UC &uc, Request *request) {
+    for (const auto &bucket : uc.getClassesByOccupation()) {
+        for (const std::string &classCode : bucket.second) {
+            const Class &class_ = *uc.getClasses().find(Class(classCode, uc.getUcCode()));
+            if (!checkClassCap(class_, request))
+                return nullptr;
+            if (checkScheduleConflicts(student, class_, request)) {
+                request->accept();      // The Classes skipped before this one rejected it
+                return &class_;
+            }
+        }
     }
-    found = false;
-    return *uc.getClasses().begin();
+    return nullptr;
 }
 
 /**
@@ -525,10 +825,11 @@ Class Course::chooseClassFromUC(Student *student, UC &uc, Request *request, bool
  * @details Time Complexity O(n log m) n= number of lectures  m= number of strings in checkUC (getNumberUcs)
  */
 bool Course::checkNumberUCs(Student *student, Request *request){
+    METRICS_TIMER(CHECK_NUMBER_UCS);
     if(student->getNumberUcs()<7)
         return true;
     else {
-        request->setMessage("Student is already registered in maximum number of UC's (7).\n");
+        request->reject(Request::MAX_UCS);
         return false;
     }
 }
@@ -540,7 +841,7 @@ bool Course::checkNumberUCs(Student *student, Request *request){
  * @param currentClass
  * @param nextClass
  * @param request
- * @details Time Complexity O(n log n + m *k) n= number of classes (checkUcBalance), m= number of not theoric lectures of Student k= number of lectures of Class (checkScheduleConflicts)
+ * @details Time Complexity O(k + log d) k= number of classes of Student (checkScheduleConflicts), d= number of distinct occupations of the Classes of the UC (checkUcBalance)
  */
 bool Course::canChooseClass(const Student *student, const UC &uc, const Class &currentClass, const Class &nextClass, Request *request) {
     if (checkScheduleConflicts(student, nextClass, request) && checkClassCap(nextClass, request) && checkUcBalance(student,uc,currentClass, nextClass, request)) {
@@ -550,33 +851,24 @@ bool Course::canChooseClass(const Student *student, const UC &uc, const Class &c
 }
 
 /**
- * @brief Checks the balance of the Classes of a Student
+ * @brief Checks the balance of the Classes of a UC: moving the Student from currentClass to nextClass can't leave a
+ * difference bigger than 4 between the most and the least occupied Classes, unless it doesn't make the current one worse
  * @param student
  * @param uc
  * @param currentClass
  * @param nextClass
  * @param request
- * @details Time Complexity O(n log n) n= number of classes (vector)
+ * @details Time Complexity O(1), the minimum and maximum occupations and the number of Classes with each are kept by the
+ * UC (see UC::getOccupationSpreadAfterMove)
  */
 bool Course::checkUcBalance(const Student *student, const UC &uc, const Class &currentClass, const Class &nextClass, Request *request) {
-    std::set<Class> classesSet = uc.getClasses();
-    std::vector<std::pair<Class, int>> classes;
-    for (Class class_ : classesSet) {
-        if (class_.getUC() ==nextClass.getUC())
-            classes.push_back({class_, class_.getOccupation()+1});
-
-        else if(class_.getUC() ==currentClass.getUC())
-            classes.push_back({class_, class_.getOccupation()-1});
-
-        else
-            classes.push_back({class_, class_.getOccupation()});
-    }
-    std::sort(classes.begin(), classes.end(), [] (std::pair<Class, int> class1, std::pair<Class, int> class2) { return (class1.second < class2.second); });
-    if ((classes[classes.size()-1].second - classes[0].second)<=4)
+    METRICS_TIMER(CHECK_UC_BALANCE);
+    if (currentClass.getClassCode() == nextClass.getClassCode())
+        return true;
+    int spread = uc.getOccupationSpreadAfterMove(currentClass.getOccupation(), nextClass.getOccupation());
+    if (spread <= 4 || spread <= uc.getOccupationSpread())
         return true;
-    std::ostringstream oss;
-    oss << "Can't switch to class " << nextClass.getClassCode() << " because it disturbs the class occupation balance.\n";
-    request->setMessage(oss.str());
+    request->reject(Request::UC_BALANCE, nextClass.getUC(), nextClass.getClassCode());
     return false;
 }
 
@@ -585,12 +877,11 @@ bool Course::checkUcBalance(const Student *student, const UC &uc, const Class &c
  * @param class_
  * @param request
  */
-bool Course::checkClassCap(const Class class_, Request *request){
+bool Course::checkClassCap(const Class &class_, Request *request){
+    METRICS_TIMER(CHECK_CLASS_CAP);
     if (class_.getStudents().size()<CLASS_CAP)
         return true;
-    std::ostringstream oss;
-    oss << "Can't join class " << class_.getClassCode() << " because it's full.\n";
-    request->setMessage(oss.str());
+    request->reject(Request::CLASS_FULL, class_.getUC(), class_.getClassCode());
     return false;
 }
 
@@ -599,20 +890,321 @@ bool Course::checkClassCap(const Class class_, Request *request){
  * @param student
  * @param class_
  * @param request
- * @details Time Complexity O(n*m) n= number of not theoric lectures of Student m= number of lectures of Class
- */
-bool Course::checkScheduleConflicts(const Student *student, const Class class_, Request *request){
-    for(Lecture lecture:student->getSchedule().getLectures()){
-        if(lecture.getType()!="T"){
-            for(Lecture classLecture:class_.getSchedule().getLectures()){
-                if(classLecture.getType()!="T" && lecture.overlaps(classLecture)){
-                    std::ostringstream oss;
-                    oss << "Can't join class " << class_.getClassCode() << " since this class's schedule overlaps with the student's schedule.\n";
-                    request->setMessage(oss.str());
-                    return false;
+ * @details Time Complexity O(k) k= number of classes of Student
+ */
+bool Course::checkScheduleConflicts(const Student *student, const Class &class_, Request *request){
+    METRICS_TIMER(CHECK_SCHEDULE_CONFLICTS);
+    if (hasScheduleConflicts(student, class_)) {
+        request->reject(Request::SCHEDULE_CONFLICT, class_.getUC(), class_.getClassCode());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if a not theoric lecture of the Class overlaps a not theoric lecture of the Student, without
+ * rejecting any Request. The conflicts between Classes are precomputed, so only the row of the Class is read.
+ * @param student
+ * @param class_
+ * @details Time Complexity O(k) k= number of classes of Student
+ */
+bool Course::hasScheduleConflicts(const Student *student, const Class &class_) const {
+    if (class_.getIndex() < 0)
+        return false;
+    return conflicts.conflictsWithAny(class_.getIndex(), student->getClassIndexes());
+}
+
+/**
+ * @brief Checks if any two Classes of a Student have overlapping not theoric lectures, e.g. after the timetable changed
+ * @param student
+ * @details Time Complexity O(k^2) k= number of classes of Student
+ */
+bool Course::hasScheduleConflicts(const Student *student) const {
+    const std::vector<int> &classes = student->getClassIndexes();
+    for (size_t i = 0; i < classes.size(); i++) {
+        for (size_t j = i + 1; j < classes.size(); j++) {
+            if (conflicts.conflicts(classes[i], classes[j]))
+                return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Assesses many JoinRequests at once. The requests to each UC are assigned together by ClassAssignment, so the
+ * result doesn't depend on their order and as many as possible are accepted with the Classes balanced.
+ * @param requests
+ * @return number of requests accepted, the others are rejected with the reason
+ * @note A Student that asks to join the same UC more than once in the batch, and requests that already name the Class,
+ * are assessed one by one after the batch. The Class chosen is kept in each request accepted.
+ * @details Time Complexity O(r * (k * n / 64 + c) + flow) r = number of requests, k = number of classes of Student, n = number of Classes of the Course, c = number of classes of the UC, flow = ClassAssignment::solve
+ */
+int Course::assessJoinBatch(const std::vector<JoinRequest*> &requests) {
+    METRICS_TIMER(ASSESS_JOIN_BATCH);
+    std::map<std::string, std::vector<JoinRequest*>> requestsByUc;
+    for (JoinRequest *request : requests)
+        requestsByUc[request->getUcCode()].push_back(request);
+
+    int accepted = 0;
+    std::vector<JoinRequest*> repeated;
+    for (auto &[ucCode, ucRequests] : requestsByUc) {
+        auto ucNode = UCs.extract(UC(ucCode));
+        if (ucNode.empty()) {
+            for (JoinRequest *request : ucRequests)
+                request->reject(Request::UC_NOT_FOUND, ucCode);
+            continue;
+        }
+        UC &uc = ucNode.value();
+        std::vector<const Class*> classes;
+        ClassAssignment assignment(CLASS_CAP, 4);
+        for (const Class &class_ : uc.getClasses()) {
+            classes.push_back(&class_);
+            assignment.addClass(class_.getOccupation());
+        }
+
+        std::vector<std::pair<JoinRequest*, Student*>> candidates;
+        std::set<Student*> seen;
+        for (JoinRequest *request : ucRequests) {
+            Student *student = findStudentByCode(request->getStudentCode());
+            if (student == nullptr) {
+                request->reject(Request::STUDENT_NOT_FOUND);
+                continue;
+            }
+            if (!seen.insert(student).second || !request->getClassCode().empty()) {
+                repeated.push_back(request);
+                continue;
+            }
+            if (!checkNumberUCs(student, request))
+                continue;
+            // Classes conflicting with any Class of the Student, tested once for every Class of the UC
+            ConflictMatrix::Row conflicting = conflicts.getConflicts(student->getClassIndexes());
+            std::vector<int> eligible;
+            for (size_t class_ = 0; class_ < classes.size(); class_++) {
+                if (!ConflictMatrix::contains(conflicting, classes[class_]->getIndex()))
+                    eligible.push_back((int) class_);
+            }
+            assignment.addStudent(eligible);
+            candidates.push_back({request, student});
+        }
+
+        std::vector<int> assigned = assignment.solve();
+        // The codes are copied because adding a Student takes the Class out of the UC
+        std::vector<std::string> classCodes;
+        for (const Class *class_ : classes)
+            classCodes.push_back(class_->getClassCode());
+        for (size_t candidate = 0; candidate < candidates.size(); candidate++) {
+            auto [request, student] = candidates[candidate];
+            if (assigned[candidate] >= 0) {
+                request->setClassCode(classCodes[assigned[candidate]]);
+                Timeslots::Mask busyBefore = student->getSchedule().getBusySlots();
+                uc.addStudent(student, request->getClassCode());
+                updateSlotOccupation(busyBefore, student->getSchedule().getBusySlots());
+                accepted++;
+            }
+            else if (classes.empty())
+                request->reject(Request::CLASS_FULL, ucCode);
+            else {
+                // Reason given with the first Class the Student could have joined, if any
+                const Class *class_ = classes.front();
+                bool eligible = false;
+                for (const Class *other : classes) {
+                    if (!hasScheduleConflicts(student, *other)) {
+                        class_ = other;
+                        eligible = true;
+                        break;
+                    }
                 }
+                if (!eligible)
+                    request->reject(Request::SCHEDULE_CONFLICT, ucCode, class_->getClassCode());
+                else if (assignment.isLimitedByBalance() && class_->getOccupation() < CLASS_CAP)
+                    request->reject(Request::UC_BALANCE, ucCode, class_->getClassCode());
+                else
+                    request->reject(Request::CLASS_FULL, ucCode, class_->getClassCode());
             }
         }
+        UCs.insert(std::move(ucNode));
     }
-    return true;
+
+    for (JoinRequest *request : repeated)
+        accepted += tryRequest(request);
+    for (const JoinRequest *request : requests) {
+        if (request->getRejection() != Request::ACCEPTED)
+            METRICS_REJECTION(request->getRejection());
+    }
+    return accepted;
+}
+
+/**
+ * @brief Assesses many SwitchClassRequests at once. Each one is first assessed on its own, in order. The ones rejected
+ * only because the next Class is full or the UC would lose its balance wait for a partner: in each UC the waiting
+ * switches form a graph between Classes and its cycles (two students swapping Classes, or longer chains) are done
+ * together, since they don't change the occupation of any Class.
+ * @param requests
+ * @return number of requests accepted, the others keep the reason of their rejection
+ * @note Only the first waiting switch of each Student in a UC takes part in the cycles
+ * @details Time Complexity O(r * assessRequest + r log r + r * k) r = number of requests, k = number of classes of Student,
+ * the cycles are found in O(r) and each switch of a cycle is checked again in O(k)
+ */
+int Course::assessSwitchClassBatch(const std::vector<SwitchClassRequest*> &requests) {
+    METRICS_TIMER(ASSESS_SWITCH_CLASS_BATCH);
+    int accepted = 0;
+    std::map<std::string, std::vector<SwitchClassRequest*>> waitingByUc;
+    for (SwitchClassRequest *request : requests) {
+        if (tryRequest(request))
+            accepted++;
+        else if (request->getRejection() == Request::CLASS_FULL || request->getRejection() == Request::UC_BALANCE)
+            waitingByUc[request->getUcCode()].push_back(request);
+    }
+
+    for (auto &[ucCode, waiting] : waitingByUc) {
+        auto ucNode = UCs.extract(UC(ucCode));
+        if (ucNode.empty())
+            continue;
+        UC &uc = ucNode.value();
+        std::map<std::string, int> classIndexes;
+        for (const Class &class_ : uc.getClasses())
+            classIndexes.emplace(class_.getClassCode(), (int) classIndexes.size());
+
+        // Switches that can take part in a cycle: the Student is in the current Class and waits only once
+        SwapCycles graph((int) classIndexes.size());
+        std::vector<std::pair<SwitchClassRequest*, Student*>> switches;
+        std::set<Student*> seen;
+        for (SwitchClassRequest *request : waiting) {
+            Student *student = findStudentByCode(request->getStudentCode());
+            auto current = uc.getClasses().find(Class(request->getClassCodeCurrent(), ucCode));
+            if (current == uc.getClasses().end() || current->getStudents().count(student) == 0 ||
+                request->getClassCodeCurrent() == request->getClassCodeNext() || !seen.insert(student).second)
+                continue;
+            graph.addSwitch(classIndexes[request->getClassCodeCurrent()], classIndexes[request->getClassCodeNext()]);
+            switches.push_back({request, student});
+        }
+
+        // Every Student of a cycle leaves before anyone joins, so no Class goes over its capacity
+        for (const std::vector<int> &cycle : graph.findCycles()) {
+            // The requests assessed since a switch waits (e.g. the cycles of other UC's) may have changed the Classes
+            // of its Student, so its next Class is checked again against the ones it keeps. A cycle with a conflict
+            // isn't done.
+            bool conflicting = false;
+            for (int switch_ : cycle) {
+                auto [request, student] = switches[switch_];
+                int currentIndex = uc.getClasses().find(Class(request->getClassCodeCurrent(), ucCode))->getIndex();
+                int nextIndex = uc.getClasses().find(Class(request->getClassCodeNext(), ucCode))->getIndex();
+                std::vector<int> kept = student->getClassIndexes();
+                kept.erase(std::remove(kept.begin(), kept.end(), currentIndex), kept.end());
+                if (nextIndex >= 0 && conflicts.conflictsWithAny(nextIndex, kept)) {
+                    request->reject(Request::SCHEDULE_CONFLICT, ucCode, request->getClassCodeNext());
+                    conflicting = true;
+                    break;
+                }
+            }
+            if (conflicting)
+                continue;
+            std::vector<Timeslots::Mask> busyBefore;
+            for (int switch_ : cycle) {
+                auto [request, student] = switches[switch_];
+                busyBefore.push_back(student->getSchedule().getBusySlots());
+                uc.removeStudent(student, request->getClassCodeCurrent());
+            }
+            for (size_t i = 0; i < cycle.size(); i++) {
+                auto [request, student] = switches[cycle[i]];
+                uc.addStudent(student, request->getClassCodeNext());
+                updateSlotOccupation(busyBefore[i], student->getSchedule().getBusySlots());
+                request->accept();
+                accepted++;
+            }
+        }
+        UCs.insert(std::move(ucNode));
+    }
+    for (const SwitchClassRequest *request : requests) {
+        if (request->getRejection() != Request::ACCEPTED)
+            METRICS_REJECTION(request->getRejection());
+    }
+    return accepted;
+}
+
+/**
+ * @brief Does again requests that were accepted before, in the order they were done (e.g. the request history).
+ * Consecutive class switches are assessed together, so that the swaps done by a file of requests are done again. Like
+ * in assessRequestBatch, a run of switches ends before a second switch of the same Student.
+ * @param requests
+ * @details Time Complexity O(r * (assessRequest + log r)) r = number of requests
+ */
+void Course::replayRequests(const std::vector<Request*> &requests) {
+    METRICS_TIMER(REPLAY);
+    std::vector<SwitchClassRequest*> switches;
+    std::set<std::string> students;
+    for (Request *request : requests) {
+        SwitchClassRequest *switchClassReq = dynamic_cast<SwitchClassRequest*>(request);
+        if (!switches.empty() && (switchClassReq == nullptr || students.count(request->getStudentCode()) > 0)) {
+            assessSwitchClassBatch(switches);
+            switches.clear();
+            students.clear();
+        }
+        if (switchClassReq != nullptr) {
+            switches.push_back(switchClassReq);
+            students.insert(request->getStudentCode());
+        }
+        else
+            assessRequest(request);
+    }
+    if (!switches.empty())
+        assessSwitchClassBatch(switches);
+}
+
+/**
+ * @brief Assesses a batch of requests, e.g. a file of requests, in their order. Each run of consecutive Join requests
+ * is assigned together (assessJoinBatch) and each run of consecutive class switches is assessed together
+ * (assessSwitchClassBatch, which also does the swaps between students). The other requests are assessed one by one.
+ * @param requests
+ * @return number of requests accepted. Each one is accepted or keeps the reason of its rejection.
+ * @note A run ends before a second request of the same Student, so the requests of a Student are always done in the
+ * order they are given, e.g. a Join followed by a Leave of the same UC
+ * @details Time Complexity O(r * (assessRequest + log r) + assessSwitchClassBatch + assessJoinBatch) r = number of
+ * requests
+ */
+int Course::assessRequestBatch(const std::vector<Request*> &requests) {
+    int accepted = 0;
+    std::vector<SwitchClassRequest*> switches;
+    std::vector<JoinRequest*> joins;
+    std::set<std::string> students;     // Students of the run being gathered
+    for (Request *request : requests) {
+        JoinRequest *joinReq = dynamic_cast<JoinRequest*>(request);
+        SwitchClassRequest *switchClassReq = dynamic_cast<SwitchClassRequest*>(request);
+        bool repeated = students.count(request->getStudentCode()) > 0;
+        if (!joins.empty() && (joinReq == nullptr || repeated)) {
+            accepted += assessJoinBatch(joins);
+            joins.clear();
+            students.clear();
+        }
+        if (!switches.empty() && (switchClassReq == nullptr || repeated)) {
+            accepted += assessSwitchClassBatch(switches);
+            switches.clear();
+            students.clear();
+        }
+        if (joinReq != nullptr) {
+            joins.push_back(joinReq);
+            students.insert(request->getStudentCode());
+        }
+        else if (switchClassReq != nullptr) {
+            switches.push_back(switchClassReq);
+            students.insert(request->getStudentCode());
+        }
+        else
+            accepted += assessRequest(request);
+    }
+    if (!switches.empty())
+        accepted += assessSwitchClassBatch(switches);
+    if (!joins.empty())
+        accepted += assessJoinBatch(joins);
+    return accepted;
+}
+
+/**
+ * @brief Takes the seats freed by the requests accepted since the last call, so that someone waiting can take them
+ * @return seats freed (UC code, Class code), in the order they were freed
+ */
+std::vector<std::pair<std::string, std::string>> Course::takeFreedSeats() {
+    std::vector<std::pair<std::string, std::string>> seats;
+    seats.swap(freedSeats);
+    return seats;
 }
@@ -2,9 +2,12 @@
 #define PROJETO_COURSE_H
 
 #include <vector>
+#include <map>
+#include <memory>
 #include "Student.h"
 #include "Request.h"
 #include "UC.h"
+#include "ConflictMatrix.h"
 #include "JoinRequest.h"
 #include "LeaveRequest.h"
 #include "SwitchClassRequest.h"
@@ -18,44 +21,94 @@ class Course {
 private:
     std::string name;
     std::set<UC> UCs;
-    std::set<Student*, cmp> students;
+    /**
+     * Students of the Course indexed by code. The Course is their only owner, Classes keep non-owning pointers to them.
+     */
+    std::map<std::string, std::unique_ptr<Student>> students;
+    /**
+     * Seats freed by the requests accepted (UC code, Class code), until they are taken by takeFreedSeats
+     */
+    std::vector<std::pair<std::string, std::string>> freedSeats;
+    /**
+     * Lectures occurring in each half-hour slot of the week, with the Class they belong to. The Lectures and Classes are
+     * nodes of the sets of the UC's, which keep their address while they are taken out and put back.
+     */
+    std::vector<std::vector<std::pair<const Lecture*, const Class*>>> lecturesBySlot;
+    /**
+     * Number of different students in session in each half-hour slot of the week
+     */
+    std::vector<int> studentsBySlot;
+    /**
+     * Classes with overlapping not theoric Lectures, by the index of each Class
+     */
+    ConflictMatrix conflicts;
+    /**
+     * Incremented every time a timetable changes (a Lecture is added or removed), so that what is built from the timetables can
+     * be cached until then
+     */
+    unsigned long timetableVersion;
     static const int CLASS_CAP = 26;
 
+    bool tryRequest(Request *request);
+    bool assessStudentRequest(Student *student, Request *request);
+    void updateSlotOccupation(const Timeslots::Mask &before, const Timeslots::Mask &after);
+
 public:
     Course();
+    Course(const Course &course) = delete;
+    Course& operator=(const Course &course) = delete;
+    Course(Course &&course) = default;
+    Course& operator=(Course &&course) = default;
+    std::unique_ptr<Course> clone() const;
     ~Course();
-    std::string getName() const;
+    const std::string& getName() const;
     void addUC(std::string ucCode);
     void addClass(std::string classCode, std::string ucCode);
-    void addStudent(std::string studentCode, std::string studentName, std::string ucCode, std::string classCode);
-    void addLecture(std::string classCode, std::string ucCode, std::string type, std::string weekday, float startHour, float duration);
-    Schedule getStudentSchedule(std::string studentCode) const;
-    Schedule getClassSchedule( std::string classCode) const;
-    Schedule getUcSchedule( std::string ucCode) const;
-    std::vector<Student*> getStudentsInClass(std::string classCode, std::string ucCode) const;
-    std::vector<Student*> getStudentsInUC(std::string ucCode) const;
-    std::vector<Student*> getStudentsInYear(std::string year) const;
+    bool addStudent(std::string studentCode, std::string studentName, const std::string &ucCode, const std::string &classCode);
+    bool addLecture(const std::string &classCode, std::string ucCode, std::string type, const std::string &weekday, float startHour, float duration);
+    bool removeLecture(const std::string &classCode, const std::string &ucCode, const std::string &type, const std::string &weekday, float startHour, float duration);
+    bool removeStudent(const std::string &studentCode, const std::string &ucCode, const std::string &classCode);
+    Schedule getStudentSchedule(const std::string &studentCode) const;
+    Schedule getClassSchedule(const std::string &classCode) const;
+    Schedule getUcSchedule(const std::string &ucCode) const;
+    std::vector<Student*> getStudentsInClass(const std::string &classCode, const std::string &ucCode) const;
+    std::vector<Student*> getStudentsInUC(const std::string &ucCode) const;
+    std::vector<Student*> getStudentsInYear(const std::string &year) const;
     std::vector<Student*> getStudentsInCourse() const;
     std::vector<Student*> getStudentsInAtLeastUCs(int n) const;
-    std::vector<UC> getUCsInYear(std::string year) const;
-    std::vector<Class> getClassesInUC(std::string ucCode) const;
-    std::set<Class> getStudentClasses(std::string studentCode) const;
+    std::vector<UC> getUCsInYear(const std::string &year) const;
+    std::vector<Class> getClassesInUC(const std::string &ucCode) const;
+    std::set<Class> getStudentClasses(const std::string &studentCode) const;
+    Timeslots::Mask getCommonFreeSlots(const std::vector<Student*> &students) const;
+    std::vector<int> getSlotAvailability(const std::vector<Student*> &students) const;
+    const std::vector<std::pair<const Lecture*, const Class*>>& getLecturesAt(int weekday, float hour) const;
+    int getStudentsInSessionAt(int weekday, float hour) const;
+    unsigned long getTimetableVersion() const;
     bool assessRequest(Request *request);
+    int assessJoinBatch(const std::vector<JoinRequest*> &requests);
+    int assessSwitchClassBatch(const std::vector<SwitchClassRequest*> &requests);
+    void replayRequests(const std::vector<Request*> &requests);
+    int assessRequestBatch(const std::vector<Request*> &requests);
+    std::vector<std::pair<std::string, std::string>> takeFreedSeats();
 
     std::vector<Class> getClasses() const;
+    std::vector<const Class*> getClassesByIndex() const;
     std::vector<UC> getUCs() const;
+    const std::set<UC>& getUCsByCode() const;
     std::vector<std::pair<std::string, int>> getYearOccupation() const;
     int getOccupation() const;
-    Student* findStudentByCode(std::string studentCode) const;
-    UC findUcByCode(std::string ucCode) const;
-    Class findClassByCode(std::string classCode, std::string ucCode) const;
+    Student* findStudentByCode(const std::string &studentCode) const;
+    UC findUcByCode(const std::string &ucCode) const;
+    Class findClassByCode(const std::string &classCode, const std::string &ucCode) const;
 
-    Class chooseClassFromUC(Student *student, UC &uc, Request *request, bool &found);
+    const Class* chooseClassFromUC(const Student *student, const UC &uc, Request *request);
     bool checkNumberUCs(Student *student, Request *request);
     bool checkUcBalance(const Student *student, const UC &uc, const Class &currentClass, const Class &nextClass, Request *request);
     bool canChooseClass(const Student *student, const UC &uc, const Class &currentClass, const Class &nextClass, Request *request);
-    bool checkClassCap(const Class class_, Request *request);
-    bool checkScheduleConflicts(const Student *student, const Class class_, Request *request);
+    bool checkClassCap(const Class &class_, Request *request);
+    bool checkScheduleConflicts(const Student *student, const Class &class_, Request *request);
+    bool hasScheduleConflicts(const Student *student, const Class &class_) const;
+    bool hasScheduleConflicts(const Student *student) const;
 };
 
 
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include "DataWatcher.h"
+
+const char *const DataWatcher::FILES[3] = {"classes_per_uc.csv", "classes.csv", "students_classes.csv"};
+
+/**
+ * @brief Constructor of the DataWatcher, starts watching the data files
+ * @param course Course loaded from the data files, changed in place by poll
+ * @param dataDir directory containing the data files
+ */
+DataWatcher::DataWatcher(Course &course, std::string dataDir) : course(course), dataDir(std::move(dataDir)) {
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0 && inotify_add_watch(fd, this->dataDir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(fd);
+        fd = -1;
+    }
+    // Read after the watch is added, so that a change made meanwhile is still seen
+    for (const char *file : FILES)
+        readRows(this->dataDir + file, rows[file]);
+}
+
+/**
+ * @brief Destructor of the DataWatcher, stops watching the data files
+ */
+DataWatcher::~DataWatcher() {
+    if (fd >= 0)
+        close(fd);
+}
+
+/**
+ * @brief Checks if the data files are being watched, they aren't if inotify isn't available
+ */
+bool DataWatcher::isWatching() const {
+    return fd >= 0;
+}
+
+/**
+ * @brief Waits for the data files to be written, and applies the rows that changed to the Course
+ * @param report set to the changes applied
+ * @param timeoutMs time to wait, 0 to only check, -1 to wait until a file is written
+ * @return true if the rows of a data file changed
+ * @details Time Complexity O(r log(r) + c) r = number of rows of the files written, c = cost of applying the rows that
+ * changed (see Course::addLecture, Course::removeLecture, Course::addStudent and Course::removeStudent)
+ */
+bool DataWatcher::poll(Report &report, int timeoutMs) {
+    report = Report();
+    if (fd < 0)
+        return false;
+    pollfd watched{fd, POLLIN, 0};
+    if (::poll(&watched, 1, timeoutMs) <= 0)
+        return false;
+    auto start = std::chrono::steady_clock::now();
+    std::set<std::string> written;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char *event = buffer; event < buffer + length; ) {
+            const inotify_event *watchedEvent = reinterpret_cast<const inotify_event*>(event);
+            if (watchedEvent->len > 0)
+                written.insert(watchedEvent->name);
+            event += sizeof(inotify_event) + watchedEvent->len;
+        }
+    }
+    std::set<Student*> changed;
+    for (const char *file : FILES) {
+        if (written.count(file) > 0)
+            reload(file, report, changed);
+    }
+    if (report.files.empty())
+        return false;
+    for (const Student *student : changed) {
+        if (course.hasScheduleConflicts(student))
+            report.conflicts.push_back(student->getStudentCode());
+    }
+    std::sort(report.conflicts.begin(), report.conflicts.end());
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+/**
+ * @brief Reads a data file again and applies the rows removed from it and then the ones added to it. A row that is
+ * still in the file (the file had it more than once) is not removed from the Course.
+ * @param file name of the data file
+ * @param report counts of the rows applied
+ * @param changed students whose schedules changed
+ * @details Time Complexity O(r log(r) + c), see poll
+ */
+void DataWatcher::reload(const std::string &file, Report &report, std::set<Student*> &changed) {
+    std::vector<std::string> newRows;
+    if (!readRows(dataDir + file, newRows))
+        return;
+    std::vector<std::string> &oldRows = rows[file];
+    std::vector<std::string> removedRows, addedRows;
+    std::set_difference(oldRows.begin(), oldRows.end(), newRows.begin(), newRows.end(), std::back_inserter(removedRows));
+    std::set_difference(newRows.begin(), newRows.end(), oldRows.begin(), oldRows.end(), std::back_inserter(addedRows));
+    if (removedRows.empty() && addedRows.empty())
+        return;
+    report.files.push_back(file);
+    for (const std::string &row : removedRows) {
+        if (std::binary_search(newRows.begin(), newRows.end(), row) || applyRow(file, row, false, changed))
+            report.removed++;
+        else
+            report.ignored++;
+    }
+    for (const std::string &row : addedRows) {
+        if (std::binary_search(oldRows.begin(), oldRows.end(), row) || applyRow(file, row, true, changed))
+            report.added++;
+        else
+            report.ignored++;
+    }
+    oldRows = std::move(newRows);
+}
+
+/**
+ * @brief Applies a row added to a data file, or removed from it, to the Course
+ * @param file name of the data file
+ * @param row
+ * @param added true if the row was added, false if it was removed
+ * @param changed the students whose schedules the row changes are added to it
+ * @return false if the row can't be applied: it is malformed, names a UC, Class or Lecture that doesn't exist, or
+ * removes a Class
+ */
+bool DataWatcher::applyRow(const std::string &file, const std::string &row, bool added, std::set<Student*> &changed) {
+    std::istringstream ss(row);
+    if (file == "classes_per_uc.csv") {
+        std::string ucCode, classCode;
+        getline(ss, ucCode, ',');
+        getline(ss, classCode);
+        if (!added)
+            return false;
+        course.addUC(ucCode);
+        course.addClass(classCode, ucCode);
+        return true;
+    }
+    if (file == "classes.csv") {
+        std::string classCode, ucCode, weekday, startHour, duration, type;
+        getline(ss, classCode, ',');
+        getline(ss, ucCode, ',');
+        getline(ss, weekday, ',');
+        getline(ss, startHour, ',');
+        getline(ss, duration, ',');
+        getline(ss, type);
+        float startHourF, durationF;
+        try {
+            startHourF = std::stof(startHour);
+            durationF = std::stof(duration);
+        } catch (const std::exception &) {
+            return false;
+        }
+        bool applied = added ? course.addLecture(classCode, ucCode, type, weekday, startHourF, durationF)
+                             : course.removeLecture(classCode, ucCode, type, weekday, startHourF, durationF);
+        if (!applied)
+            return false;
+        for (Student *student : course.getStudentsInClass(classCode, ucCode))
+            changed.insert(student);
+        return true;
+    }
+    std::string studentCode, studentName, ucCode, classCode;
+    getline(ss, studentCode, ',');
+    getline(ss, studentName, ',');
+    getline(ss, ucCode, ',');
+    getline(ss, classCode);
+    bool applied = added ? course.addStudent(studentCode, studentName, ucCode, classCode)
+                         : course.removeStudent(studentCode, ucCode, classCode);
+    // The row of a Student without UC's (code,name,,) only creates it, and the Student stays when the row is removed
+    if (ucCode.empty() && classCode.empty())
+        return true;
+    if (!applied)
+        return false;
+    if (Student *student = course.findStudentByCode(studentCode))
+        changed.insert(student);
+    return true;
+}
+
+/**
+ * @brief Reads the rows of a data file, without its header and line endings, sorted
+ * @param path
+ * @param rows set to the rows read
+ * @return false if the file couldn't be opened, rows is left as it was
+ */
+bool DataWatcher::readRows(const std::string &path, std::vector<std::string> &rows) {
+    std::ifstream file(path);
+    if (!file)
+        return false;
+    std::string line;
+    rows.clear();
+    getline(file, line); // ignorar header
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        rows.push_back(line);
+    }
+    std::sort(rows.begin(), rows.end());
+    return true;
+}
+
+/**
+ * @brief Prints the changes of a reload and the students with schedule conflicts
+ * @param os
+ * @param report
+ */
+void DataWatcher::printReport(std::ostream &os, const Report &report) {
+    if (report.files.empty())
+        return;
+    os << "Reloaded";
+    for (const std::string &file : report.files)
+        os << " " << file;
+    os << std::fixed << std::setprecision(2) << ": " << report.added << " rows added and " << report.removed
+       << " removed in " << report.seconds * 1000 << " ms\n";
+    if (report.ignored > 0)
+        os << report.ignored << " rows were ignored, they are malformed, name a class or lecture that doesn't exist "
+           << "or remove a class (needs a restart)\n";
+    if (report.conflicts.empty()) {
+        os << "No student changed has schedule conflicts\n";
+        return;
+    }
+    os << report.conflicts.size() << " students changed have schedule conflicts:";
+    for (const std::string &studentCode : report.conflicts)
+        os << " " << studentCode;
+    os << "\n";
+}
@@ -0,0 +1,77 @@
+#ifndef PROJETO_DATAWATCHER_H
+#define PROJETO_DATAWATCHER_H
+
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+#include "Course.h"
+
+/**
+ * @brief DataWatcher applies the changes of the data files to a running Course, so that fixing a row (e.g. a lecture
+ * moved in classes.csv) doesn't need a restart that redoes every request. The data directory is watched with inotify:
+ * when a data file is written, or another file is renamed over it, its rows are compared with the ones it had and only
+ * the rows removed and added are applied, in place. The students of the Classes changed that now have schedule
+ * conflicts are reported.
+ * @note UC's and Classes can be added but not removed, since the Classes keep their index. The rows removed from
+ * classes_per_uc.csv are ignored until the program restarts.
+ */
+
+class DataWatcher {
+public:
+    /**
+     * @brief Changes applied by a reload
+     */
+    struct Report {
+        /**
+         * Data files whose rows changed
+         */
+        std::vector<std::string> files;
+        size_t added = 0;
+        size_t removed = 0;
+        /**
+         * Rows that couldn't be applied: malformed, naming a UC, Class or Lecture that doesn't exist, or removing a
+         * Class
+         */
+        size_t ignored = 0;
+        /**
+         * Codes of the students changed (the ones of the Classes whose Lectures changed, and the ones whose Classes
+         * changed) that have schedule conflicts, sorted
+         */
+        std::vector<std::string> conflicts;
+        double seconds = 0;
+    };
+
+private:
+    Course &course;
+    std::string dataDir;
+    /**
+     * inotify descriptor watching dataDir, -1 if it couldn't be watched
+     */
+    int fd;
+    /**
+     * Rows of each data file, sorted, as they were when last applied
+     */
+    std::map<std::string, std::vector<std::string>> rows;
+    /**
+     * Data files watched, in the order their changes are applied: the Classes before their Lectures and students
+     */
+    static const char *const FILES[3];
+
+    void reload(const std::string &file, Report &report, std::set<Student*> &changed);
+    bool applyRow(const std::string &file, const std::string &row, bool added, std::set<Student*> &changed);
+    static bool readRows(const std::string &path, std::vector<std::string> &rows);
+
+public:
+    explicit DataWatcher(Course &course, std::string dataDir = "../");
+    DataWatcher(const DataWatcher &watcher) = delete;
+    DataWatcher& operator=(const DataWatcher &watcher) = delete;
+    ~DataWatcher();
+    bool isWatching() const;
+    bool poll(Report &report, int timeoutMs = 0);
+    static void printReport(std::ostream &os, const Report &report);
+};
+
+
+#endif //PROJETO_DATAWATCHER_H
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <iterator>
+#include "History.h"
+#include "Auxiliar.h"
+#include "Metrics.h"
+
+/**
+ * @brief Constructor of an empty History
+ * @param interval number of requests between two checkpoints
+ */
+History::History(size_t interval) : undos(0), interval(std::max<size_t>(interval, 1)) {}
+
+/**
+ * @brief Redoes the requests of an older history on the Course, like Course::replayRequests, and records them. The
+ * Course before them and a checkpoint every interval requests are kept.
+ * @param course Course as it was before the first request, e.g. just read from the data files
+ * @param pastRequests requests in chronological order, the History doesn't take ownership of them
+ * @details Time Complexity O(replayRequests + p / interval * Course::clone) p = number of past requests
+ * @note Must be called before any request is recorded
+ */
+void History::replay(Course &course, const std::vector<Request*> &pastRequests) {
+    std::lock_guard<std::mutex> lock(mutex);
+    rebuild(course, pastRequests);
+}
+
+/**
+ * @brief Replaces the whole History by another one, e.g. the compacted history (see HistoryCompactor). The points of
+ * the old History can't be consulted anymore.
+ * @param course Course as it was before the first request
+ * @param pastRequests requests in chronological order, the History doesn't take ownership of them
+ * @details Time Complexity O(replay)
+ */
+void History::reset(Course &course, const std::vector<Request*> &pastRequests) {
+    std::lock_guard<std::mutex> lock(mutex);
+    requests.clear();
+    times.clear();
+    checkpoints.clear();
+    undos++;        // The checkpoints being built from the old History aren't kept
+    rebuild(course, pastRequests);
+}
+
+/**
+ * @brief Redoes and records the requests of replay, with the mutex locked
+ * @param course
+ * @param pastRequests
+ */
+void History::rebuild(Course &course, const std::vector<Request*> &pastRequests) {
+    checkpoints.emplace(0, course.clone());
+    size_t first = 0;
+    for (size_t count = 1; count <= pastRequests.size(); count++) {
+        bool last = count == pastRequests.size();
+        // Class switches in a row are redone together (they may be swaps), so no checkpoint is made between them
+        bool betweenSwitches = !last && dynamic_cast<const SwitchClassRequest*>(pastRequests[count - 1]) != nullptr
+                               && dynamic_cast<const SwitchClassRequest*>(pastRequests[count]) != nullptr;
+        if (!last && (count - first < interval || betweenSwitches))
+            continue;
+        std::vector<Request*> redone(pastRequests.begin() + first, pastRequests.begin() + count);
+        course.replayRequests(redone);
+        for (const Request *request : redone) {
+            requests.push_back(Auxiliar::formatRequest(request));      // With the class chosen for a join
+            // A request older than the one before it (e.g. loaded from a file of requests) counts as done with it
+            times.push_back(times.empty() ? request->getTime() : std::max(times.back(), request->getTime()));
+        }
+        if (!last) {
+            course.takeFreedSeats();
+            checkpoints.emplace(count, course.clone());
+        }
+        first = count;
+    }
+}
+
+/**
+ * @brief Records a request done, at the current time if it doesn't have one yet. The times are kept in order (see
+ * countUntil), so a request with a time older than the last one's is recorded at the last one's time.
+ * @param request accepted request, the History doesn't take ownership of it
+ * @details Time Complexity O(1)
+ */
+void History::record(Request *request) {
+    if (request->getTime() == 0)
+        request->setTime(std::time(nullptr));
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!times.empty() && request->getTime() < times.back())
+        request->setTime(times.back());
+    requests.push_back(Auxiliar::formatRequest(request));
+    times.push_back(request->getTime());
+}
+
+/**
+ * @brief Forgets the last request, after it was undone, and the checkpoint made after it
+ * @details Time Complexity O(log(c)) c = number of checkpoints
+ */
+void History::undo() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (requests.empty())
+        return;
+    requests.pop_back();
+    times.pop_back();
+    checkpoints.erase(checkpoints.upper_bound(requests.size()), checkpoints.end());
+    undos++;
+}
+
+/**
+ * @brief Gets the number of requests done
+ */
+size_t History::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return requests.size();
+}
+
+/**
+ * @brief Gets a request done
+ * @param n number of the request, starting at 1
+ * @return request in the format of the request history, empty if there is no such request
+ */
+std::string History::getRequest(size_t n) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (n == 0 || n > requests.size())
+        return "";
+    return requests[n - 1];
+}
+
+/**
+ * @brief Counts the requests done until a time, the ones without a time are older than all the others
+ * @param time
+ * @details Time Complexity O(log(r)) r = number of requests
+ */
+size_t History::countUntil(std::time_t time) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::upper_bound(times.begin(), times.end(), time) - times.begin();
+}
+
+/**
+ * @brief Reads a point of the History
+ * @param point number of requests done (0 for the Course before any of them) or a time (see Auxiliar::parseTime)
+ * @param count set to the number of requests done at that point
+ * @return false if the point isn't a number of requests of the History nor a time
+ */
+bool History::parsePoint(const std::string &point, size_t &count) const {
+    if (!point.empty() && point.size() <= 9 && point.find_first_not_of("0123456789") == std::string::npos) {
+        count = std::stoul(point);
+        return count <= size();
+    }
+    std::time_t time;
+    if (!Auxiliar::parseTime(point, time))
+        return false;
+    count = countUntil(time);
+    return true;
+}
+
+/**
+ * @brief Rebuilds the Course as it was after a number of requests: copies the last checkpoint before them and redoes
+ * the requests after it. A checkpoint is made every interval requests redone, so the next consults near that point
+ * redo at most about interval requests.
+ * @param count number of requests done, 0 for the Course before any of them
+ * @return copy of the Course after the first count requests (or all of them, if there are fewer)
+ * @details Time Complexity O(Course::clone + d * assessRequest) d = number of requests redone, under interval once the
+ * checkpoints before the point exist. Other threads can record requests meanwhile.
+ */
+std::unique_ptr<Course> History::getCourseAfter(size_t count) {
+    METRICS_TIMER(QUERY_HISTORY);
+    std::unique_lock<std::mutex> lock(mutex);
+    count = std::min(count, requests.size());
+    auto checkpoint = std::prev(checkpoints.upper_bound(count));
+    size_t first = checkpoint->first;
+    std::shared_ptr<const Course> from = checkpoint->second;
+    std::vector<std::string> redone(requests.begin() + first, requests.begin() + count);
+    std::vector<size_t> cuts;
+    for (size_t cut = first + interval; cut < count; cut++) {
+        if (canCheckpointAfter(cut)) {
+            cuts.push_back(cut);
+            cut += interval - 1;
+        }
+    }
+    unsigned long undosBefore = undos;
+    lock.unlock();
+
+    std::unique_ptr<Course> course = from->clone();
+    std::vector<std::pair<size_t, std::shared_ptr<const Course>>> made;
+    size_t done = first;
+    for (size_t cut : cuts) {
+        redo(*course, redone.begin() + (done - first), redone.begin() + (cut - first));
+        made.emplace_back(cut, course->clone());
+        done = cut;
+    }
+    redo(*course, redone.begin() + (done - first), redone.end());
+
+    lock.lock();
+    if (undos == undosBefore)
+        checkpoints.insert(made.begin(), made.end());
+    return course;
+}
+
+/**
+ * @brief Gets the number of checkpoints kept, including the Course before any request
+ */
+size_t History::getCheckpointCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return checkpoints.size();
+}
+
+/**
+ * @brief Checks if a checkpoint can be made after a number of requests, i.e. it doesn't split class switches in a row
+ * (they are redone together, see Course::replayRequests)
+ * @param count number of requests, more than 0 and less than the number of requests done
+ */
+bool History::canCheckpointAfter(size_t count) const {
+    return !isClassSwitch(requests[count - 1]) || !isClassSwitch(requests[count]);
+}
+
+/**
+ * @brief Checks if a request is a class switch
+ * @param request in the format of the request history
+ */
+bool History::isClassSwitch(const std::string &request) {
+    return request.rfind("SwitchClass,", 0) == 0;
+}
+
+/**
+ * @brief Redoes requests on a Course, like Course::replayRequests
+ * @param course
+ * @param first first request, in the format of the request history
+ * @param last end of the requests
+ */
+void History::redo(Course &course, std::vector<std::string>::const_iterator first, std::vector<std::string>::const_iterator last) {
+    std::vector<Request*> redone;
+    for (; first != last; first++) {
+        Request *request = Auxiliar::parseRequest(*first);
+        if (request != nullptr)
+            redone.push_back(request);
+    }
+    course.replayRequests(redone);
+    course.takeFreedSeats();
+    for (Request *request : redone)
+        delete request;
+}
@@ -0,0 +1,67 @@
+#ifndef PROJETO_HISTORY_H
+#define PROJETO_HISTORY_H
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Course.h"
+
+/**
+ * @brief History keeps the requests done, in chronological order and with the time each one was done, and rebuilds
+ * the Course as it was after any of them (e.g. to settle a dispute about a change). Copies of the Course (checkpoints)
+ * are kept every CHECKPOINT_INTERVAL requests, so the Course after request n is a copy of the last checkpoint before it
+ * with at most about CHECKPOINT_INTERVAL requests redone, never the whole history.
+ * @note The requests can be recorded while other threads consult the past
+ */
+
+class History {
+private:
+    mutable std::mutex mutex;
+    /**
+     * @brief Requests done, in the format of the request history
+     */
+    std::vector<std::string> requests;
+    /**
+     * @brief When each request was done, 0 if it isn't known. In order, a request never counts as older than the one
+     * before it
+     */
+    std::vector<std::time_t> times;
+    /**
+     * @brief Course after the number of requests of the key, starting with the Course before any request. A
+     * checkpoint never changes once made.
+     */
+    std::map<size_t, std::shared_ptr<const Course>> checkpoints;
+    /**
+     * @brief Incremented when a request is undone, so that a checkpoint built from a request undone meanwhile isn't kept
+     */
+    unsigned long undos;
+    size_t interval;
+
+    void rebuild(Course &course, const std::vector<Request*> &pastRequests);
+    bool canCheckpointAfter(size_t count) const;
+    static bool isClassSwitch(const std::string &request);
+    static void redo(Course &course, std::vector<std::string>::const_iterator first, std::vector<std::string>::const_iterator last);
+
+public:
+    static const size_t CHECKPOINT_INTERVAL = 250;
+
+    explicit History(size_t interval = CHECKPOINT_INTERVAL);
+    History(const History &history) = delete;
+    History& operator=(const History &history) = delete;
+    void replay(Course &course, const std::vector<Request*> &pastRequests);
+    void reset(Course &course, const std::vector<Request*> &pastRequests);
+    void record(Request *request);
+    void undo();
+    size_t size() const;
+    std::string getRequest(size_t n) const;
+    size_t countUntil(std::time_t time) const;
+    bool parsePoint(const std::string &point, size_t &count) const;
+    std::unique_ptr<Course> getCourseAfter(size_t count);
+    size_t getCheckpointCount() const;
+};
+
+
+#endif //PROJETO_HISTORY_H
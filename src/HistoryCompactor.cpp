@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <set>
+#include "HistoryCompactor.h"
+#include "Auxiliar.h"
+
+/**
+ * @brief Constructor of the HistoryCompactor
+ * @param baseline Course the history starts from, e.g. just read from the data files
+ */
+HistoryCompactor::HistoryCompactor(const Course &baseline) : baseline(baseline) {}
+
+/**
+ * @brief Gets the UC's a request is about
+ * @param request
+ */
+static std::vector<std::string> getUcCodes(const Request *request) {
+    if (const JoinRequest *joinReq = dynamic_cast<const JoinRequest*>(request))
+        return {joinReq->getUcCode()};
+    if (const LeaveRequest *leaveReq = dynamic_cast<const LeaveRequest*>(request))
+        return {leaveReq->getUcCode()};
+    if (const SwitchUcRequest *switchUcReq = dynamic_cast<const SwitchUcRequest*>(request))
+        return {switchUcReq->getUcCodeCurrent(), switchUcReq->getUcCodeNext()};
+    if (const SwitchClassRequest *switchClassReq = dynamic_cast<const SwitchClassRequest*>(request))
+        return {switchClassReq->getUcCode()};
+    return {};
+}
+
+/**
+ * @brief Compacts a request history: redoes it on a copy of the baseline, compares the enrollments of each student it
+ * is about before and after, and writes the requests that make those changes. The Leaves go first (they free seats
+ * and UC's), then the class switches, all in a row so they are redone together like swaps, and then the Joins. A request can be rejected when redone in another
+ * order, e.g. a class switch that unbalances the UC while another student hasn't moved yet, so the rejected ones are
+ * redone again after the others. A class switch that is still rejected is split in a Leave and a Join of the Class
+ * (which doesn't depend on the balance of the UC). The result is checked against redoing the original history: the
+ * students whose changes are never accepted, or who don't end up in the same Classes, keep their original requests, and
+ * the changes are tried again in the order of the original history.
+ * @param requests history, in the format of the request history
+ * @param compacted set to the compacted history, or to the original one if no shorter one was verified. Every compacted
+ * request has the time of the last request of the original history, so it can't be consulted at any point in between.
+ * @return size of both histories and how long redoing each one takes
+ * @details Time Complexity O(replay(r) + a * p * replay(c)) r = number of requests, c = number of requests compacted,
+ * p = passes until every request is accepted, a = attempts (at most MAX_ATTEMPTS)
+ */
+HistoryCompactor::Report HistoryCompactor::compact(const std::vector<std::string> &requests, std::vector<std::string> &compacted) const {
+    Report report;
+    report.before = report.after = requests.size();
+    compacted = requests;
+
+    // Position of the last request about each UC of each student
+    std::map<std::string, std::map<std::string, size_t>> lastRequests;
+    std::map<std::string, std::vector<size_t>> studentRequests;
+    std::time_t time = 0;
+    for (size_t position = 0; position < requests.size(); position++) {
+        Request *request = Auxiliar::parseRequest(requests[position]);
+        if (request == nullptr)
+            continue;
+        time = std::max(time, request->getTime());
+        studentRequests[request->getStudentCode()].push_back(position);
+        for (const std::string &ucCode : getUcCodes(request))
+            lastRequests[request->getStudentCode()][ucCode] = position;
+        delete request;
+    }
+
+    std::unique_ptr<Course> original = baseline.clone();
+    report.secondsBefore = report.secondsAfter = redo(*original, requests);
+    std::vector<const Class*> classesBefore = baseline.getClassesByIndex();
+    std::vector<const Class*> classesAfter = original->getClassesByIndex();
+    std::vector<Change> changes;
+    // Students that keep their original requests, at first the ones that were in more than one Class of a UC they
+    // changed, which no request can leave
+    std::set<std::string> kept;
+    for (const auto &[studentCode, ucs] : lastRequests) {
+        const Student *before = baseline.findStudentByCode(studentCode);
+        const Student *after = original->findStudentByCode(studentCode);
+        if (before == nullptr || after == nullptr)
+            continue;
+        Enrollments enrollmentsBefore = getEnrollments(before, classesBefore);
+        Enrollments enrollmentsAfter = getEnrollments(after, classesAfter);
+        std::vector<Change> studentChanges;
+        for (const auto &[ucCode, position] : ucs) {
+            const std::vector<std::string> &classesFrom = enrollmentsBefore[ucCode];
+            std::vector<std::string> classesTo = enrollmentsAfter[ucCode];
+            if (classesFrom == classesTo)
+                continue;
+            if (classesFrom.size() > 1) {
+                kept.insert(studentCode);
+                break;
+            }
+            std::vector<Request*> made;
+            if (!classesFrom.empty()) {
+                auto stays = std::find(classesTo.begin(), classesTo.end(), classesFrom[0]);
+                if (stays != classesTo.end())
+                    classesTo.erase(stays);
+                else if (classesTo.empty())
+                    made.push_back(new LeaveRequest(studentCode, ucCode));
+                else {
+                    made.push_back(new SwitchClassRequest(studentCode, ucCode, classesFrom[0], classesTo[0]));
+                    classesTo.erase(classesTo.begin());
+                }
+            }
+            // A student can end up in more than one Class of a UC, e.g. joining a UC it was already in
+            for (const std::string &classCode : classesTo)
+                made.push_back(new JoinRequest(studentCode, ucCode, classCode));
+            for (Request *request : made) {
+                int order = dynamic_cast<LeaveRequest*>(request) ? 0 : dynamic_cast<SwitchClassRequest*>(request) ? 1 : 2;
+                request->setTime(time);
+                studentChanges.push_back({studentCode, order, position, Auxiliar::formatRequest(request), made.size() == 1});
+                delete request;
+            }
+        }
+        if (kept.count(studentCode) == 0)
+            changes.insert(changes.end(), studentChanges.begin(), studentChanges.end());
+    }
+
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+        bool grouped = attempt == 0;
+        std::vector<Change> pending;
+        for (const Change &change : changes) {
+            if (kept.count(change.studentCode) == 0)
+                pending.push_back(change);
+        }
+        for (const std::string &studentCode : kept) {
+            for (size_t position : studentRequests[studentCode])
+                pending.push_back({studentCode, 0, position, requests[position], false});
+        }
+        if (pending.size() >= requests.size())
+            break;
+        std::stable_sort(pending.begin(), pending.end(), [grouped](const Change &c1, const Change &c2) {
+            if (grouped && c1.order != c2.order)
+                return c1.order < c2.order;
+            return c1.position != c2.position ? c1.position < c2.position : c1.order < c2.order;
+        });
+
+        // The requests rejected are redone again after the others, until no more are accepted. The history is the
+        // requests in the order they were accepted.
+        std::unique_ptr<Course> course = baseline.clone();
+        std::vector<std::string> lines;
+        while (!pending.empty()) {
+            std::vector<std::string> pendingLines;
+            for (const Change &change : pending)
+                pendingLines.push_back(change.line);
+            std::vector<size_t> rejected;
+            redo(*course, pendingLines, &rejected);
+            std::vector<Change> next;
+            for (size_t i = 0, r = 0; i < pending.size(); i++) {
+                if (r < rejected.size() && rejected[r] == i) {
+                    next.push_back(pending[i]);
+                    r++;
+                } else
+                    lines.push_back(pending[i].line);
+            }
+            if (next.size() == pending.size() && !splitSwitches(next, time))
+                break;
+            pending = std::move(next);
+        }
+        // The students never accepted keep their requests, the next attempt in the order of the original history
+        std::vector<std::string> different;
+        for (const Change &change : pending)
+            different.push_back(change.studentCode);
+        double seconds = 0;
+        if (pending.empty()) {
+            // Or the students that don't end up in the same Classes
+            std::unique_ptr<Course> redone = baseline.clone();
+            seconds = redo(*redone, lines);
+            different = getDifferentStudents(*original, *redone);
+        }
+        if (!different.empty()) {
+            size_t keptBefore = kept.size();
+            kept.insert(different.begin(), different.end());
+            if (kept.size() == keptBefore)
+                break;
+            continue;
+        }
+        report.verified = true;
+        report.after = lines.size();
+        report.secondsAfter = seconds;
+        compacted = std::move(lines);
+        return report;
+    }
+    // Not shorter or not the same Course: the original history is kept
+    return report;
+}
+
+/**
+ * @brief Splits the class switches of the changes into a Leave of the UC and a Join of the next Class, with the same
+ * effect, e.g. when the switches are rejected only to keep the balance of the UC. A Leave takes the student out of any
+ * Class of the UC, so only the switches of students that end up in one Class of the UC are split.
+ * @param changes
+ * @param time time of the requests
+ * @return false if there was no class switch to split
+ */
+bool HistoryCompactor::splitSwitches(std::vector<Change> &changes, std::time_t time) {
+    bool split = false;
+    std::vector<Change> splitChanges;
+    for (const Change &change : changes) {
+        Request *request = Auxiliar::parseRequest(change.line);
+        const SwitchClassRequest *switchClassReq = dynamic_cast<const SwitchClassRequest*>(request);
+        if (switchClassReq != nullptr && change.onlyClass) {
+            LeaveRequest leave(change.studentCode, switchClassReq->getUcCode());
+            JoinRequest join(change.studentCode, switchClassReq->getUcCode(), switchClassReq->getClassCodeNext());
+            leave.setTime(time);
+            join.setTime(time);
+            splitChanges.push_back({change.studentCode, 0, change.position, Auxiliar::formatRequest(&leave), true});
+            splitChanges.push_back({change.studentCode, 2, change.position, Auxiliar::formatRequest(&join), true});
+            split = true;
+        } else
+            splitChanges.push_back(change);
+        delete request;
+    }
+    changes = std::move(splitChanges);
+    return split;
+}
+
+/**
+ * @brief Gets the Classes of each UC a student is in, sorted
+ * @param student
+ * @param classes Classes of the Course of the student, by index (see Course::getClassesByIndex)
+ * @details Time Complexity O(u log(u)) u = number of UC's of the student
+ */
+HistoryCompactor::Enrollments HistoryCompactor::getEnrollments(const Student *student, const std::vector<const Class*> &classes) {
+    Enrollments enrollments;
+    for (int index : student->getClassIndexes())
+        enrollments[classes[index]->getUC()].push_back(classes[index]->getClassCode());
+    for (auto &[ucCode, classCodes] : enrollments)
+        std::sort(classCodes.begin(), classCodes.end());
+    return enrollments;
+}
+
+/**
+ * @brief Compares the students of two copies of a Course, which have the same students and Classes
+ * @param course
+ * @param other
+ * @return codes of the students that aren't in the same Classes in both
+ * @details Time Complexity O(s * u log(u)) s = number of students, u = UC's per student
+ */
+std::vector<std::string> HistoryCompactor::getDifferentStudents(const Course &course, const Course &other) {
+    std::vector<std::string> different;
+    for (const Student *student : course.getStudentsInCourse()) {
+        const Student *otherStudent = other.findStudentByCode(student->getStudentCode());
+        std::vector<int> classes = student->getClassIndexes();
+        std::vector<int> otherClasses;
+        if (otherStudent != nullptr)
+            otherClasses = otherStudent->getClassIndexes();
+        std::sort(classes.begin(), classes.end());
+        std::sort(otherClasses.begin(), otherClasses.end());
+        if (otherStudent == nullptr || classes != otherClasses)
+            different.push_back(student->getStudentCode());
+    }
+    return different;
+}
+
+/**
+ * @brief Redoes a history on a Course, like it is redone at startup
+ * @param course
+ * @param requests in the format of the request history
+ * @param rejected if not nullptr, set to the positions of the requests rejected
+ * @return time it took, in seconds
+ */
+double HistoryCompactor::redo(Course &course, const std::vector<std::string> &requests, std::vector<size_t> *rejected) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Request*> redone;
+    for (const std::string &line : requests) {
+        Request *request = Auxiliar::parseRequest(line);
+        if (request != nullptr)
+            redone.push_back(request);
+    }
+    course.replayRequests(redone);
+    course.takeFreedSeats();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (size_t i = 0; i < redone.size(); i++) {
+        if (rejected != nullptr && redone[i]->getRejection() != Request::ACCEPTED)
+            rejected->push_back(i);
+        delete redone[i];
+    }
+    return seconds;
+}
+
+/**
+ * @brief Prints how much a history was compacted and how much faster it is redone
+ * @param os
+ * @param report
+ */
+void HistoryCompactor::printReport(std::ostream &os, const Report &report) {
+    if (!report.verified) {
+        os << "No shorter history gives the same course, the history of " << report.before << " requests was kept\n";
+        return;
+    }
+    os << std::fixed << std::setprecision(3)
+       << "Compacted the history from " << report.before << " to " << report.after << " requests: redoing it takes "
+       << report.secondsAfter << " s instead of " << report.secondsBefore << " s (" << std::setprecision(1)
+       << report.secondsBefore / std::max(report.secondsAfter, 1e-9) << "x faster)\n";
+}
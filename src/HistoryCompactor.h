@@ -0,0 +1,80 @@
+#ifndef PROJETO_HISTORYCOMPACTOR_H
+#define PROJETO_HISTORYCOMPACTOR_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Course.h"
+
+/**
+ * @brief HistoryCompactor rewrites a request history into a shorter one with the same effect. The requests of each
+ * student are replaced by what they changed from the Course they were done on: a Leave of each UC left, a class switch
+ * of each UC whose Class changed and a Join of each UC joined. So a Join and a Leave of the same UC disappear, class
+ * switches A→B then B→C become A→C, and a SwitchUc becomes a Leave and a Join.
+ * @note The compacted history is only given if redoing it gives exactly the same enrollments as redoing the original
+ * one, otherwise the original is kept
+ */
+
+class HistoryCompactor {
+public:
+    /**
+     * @brief Result of a compaction
+     */
+    struct Report {
+        /**
+         * Number of requests of the original and of the compacted history
+         */
+        size_t before = 0;
+        size_t after = 0;
+        /**
+         * Time taken to redo the original and the compacted history
+         */
+        double secondsBefore = 0;
+        double secondsAfter = 0;
+        /**
+         * A shorter history was found, and redoing it gives the same Course as the original one
+         */
+        bool verified = false;
+    };
+
+private:
+    /**
+     * @brief Classes of each UC a student is in, by UC code
+     */
+    typedef std::map<std::string, std::vector<std::string>> Enrollments;
+
+    /**
+     * @brief A request of the compacted history: Leaves (order 0) go before class switches (1) and Joins (2), or it
+     * goes at the position of the last request of the student about its UC in the original history
+     */
+    struct Change {
+        std::string studentCode;
+        int order;
+        size_t position;
+        std::string line;
+        /**
+         * The student ends up in a single Class of the UC, the only change about it
+         */
+        bool onlyClass;
+    };
+
+    const Course &baseline;
+    /**
+     * Attempts of compacting before keeping the original history
+     */
+    static const int MAX_ATTEMPTS = 8;
+
+    static bool splitSwitches(std::vector<Change> &changes, std::time_t time);
+    static Enrollments getEnrollments(const Student *student, const std::vector<const Class*> &classes);
+    static std::vector<std::string> getDifferentStudents(const Course &course, const Course &other);
+    static double redo(Course &course, const std::vector<std::string> &requests, std::vector<size_t> *rejected = nullptr);
+
+public:
+    explicit HistoryCompactor(const Course &baseline);
+    Report compact(const std::vector<std::string> &requests, std::vector<std::string> &compacted) const;
+    static void printReport(std::ostream &os, const Report &report);
+};
+
+
+#endif //PROJETO_HISTORYCOMPACTOR_H
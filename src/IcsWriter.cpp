@@ -0,0 +1,190 @@
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include "IcsWriter.h"
+#include "Auxiliar.h"
+
+/**
+ * @brief Constructor of the IcsWriter, works out the first date of each weekday in the term
+ * @param os stream the document is written to
+ * @param term weeks the lectures repeat
+ */
+IcsWriter::IcsWriter(std::ostream &os, const Term &term) : os(os), events(0) {
+    std::tm first{};
+    first.tm_year = term.year - 1900;
+    first.tm_mon = term.month - 1;
+    first.tm_mday = term.day;
+    first.tm_hour = 12;         // Far from midnight, so that daylight saving time never changes the date
+    first.tm_isdst = -1;
+    for (int offset = 0; offset < 7; offset++) {
+        std::tm day = first;
+        day.tm_mday += offset;
+        std::mktime(&day);
+        int weekday = (day.tm_wday + 6) % 7;        // 0 is Monday, like in the Lectures
+        if (weekday < Timeslots::DAYS)
+            firstDates[weekday] = formatDate(day);
+    }
+    std::tm last = first;
+    last.tm_mday += term.weeks * 7 - 1;
+    std::mktime(&last);
+    until = formatDate(last) + "T235959";
+
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    std::ostringstream str;
+    str << std::put_time(&utc, "%Y%m%dT%H%M%SZ");
+    stamp = str.str();
+}
+
+/**
+ * @brief Writes the start of the document
+ * @param name name of the calendar, e.g. "Schedule of student 202025232"
+ */
+void IcsWriter::begin(const std::string &name) {
+    writeLine("BEGIN:VCALENDAR");
+    writeLine("VERSION:2.0");
+    writeLine("PRODID:-//Schedule LEIC//Schedule Management//EN");
+    writeLine("CALSCALE:GREGORIAN");
+    writeLine("METHOD:PUBLISH");
+    writeLine("X-WR-CALNAME:" + escape(name));
+}
+
+/**
+ * @brief Writes a Lecture as an event repeated every week of the term, from the first day of the term on its weekday
+ * @param lecture
+ */
+void IcsWriter::writeLecture(const Lecture &lecture) {
+    const std::string &date = firstDates[lecture.getWeekday()];
+    std::string start = formatTime(lecture.getStartHour());
+    writeLine("BEGIN:VEVENT");
+    writeLine("UID:" + escape(lecture.getUC() + "-" + lecture.getClass() + "-" + lecture.getType() + "-"
+                              + std::to_string(lecture.getWeekday()) + "-" + start) + "@schedule-leic");
+    writeLine("DTSTAMP:" + stamp);
+    writeLine("DTSTART:" + date + "T" + start);
+    writeLine("DTEND:" + date + "T" + formatTime(lecture.getEndHour()));
+    writeLine("RRULE:FREQ=WEEKLY;UNTIL=" + until);
+    writeLine("SUMMARY:" + escape(lecture.getUC() + " (" + lecture.getType() + ")"));
+    writeLine("DESCRIPTION:" + escape("Class " + lecture.getClass()));
+    writeLine("END:VEVENT");
+    events++;
+}
+
+/**
+ * @brief Writes every Lecture of a Schedule
+ * @param schedule
+ * @details Time Complexity O(n) n = number of lectures
+ */
+void IcsWriter::writeSchedule(const Schedule &schedule) {
+    for (const Lecture &lecture : schedule.getLectures())
+        writeLecture(lecture);
+}
+
+/**
+ * @brief Writes the end of the document
+ */
+void IcsWriter::end() {
+    writeLine("END:VCALENDAR");
+}
+
+/**
+ * @brief Gets the number of events written
+ */
+size_t IcsWriter::getEvents() const {
+    return events;
+}
+
+/**
+ * @brief Gets a term that starts on the Monday of the current week
+ * @param weeks
+ */
+IcsWriter::Term IcsWriter::currentTerm(int weeks) {
+    std::time_t now = std::time(nullptr);
+    std::tm today{};
+    localtime_r(&now, &today);
+    today.tm_mday -= (today.tm_wday + 6) % 7;
+    today.tm_hour = 12;
+    today.tm_isdst = -1;
+    std::mktime(&today);
+    return {today.tm_year + 1900, today.tm_mon + 1, today.tm_mday, weeks};
+}
+
+/**
+ * @brief Reads a term
+ * @param firstDay date of the first day, e.g. "2023-09-11"
+ * @param weeks number of weeks, at least 1
+ * @param term set to the term read
+ * @return false if the date (yyyy-mm-dd) or the number of weeks isn't valid
+ */
+bool IcsWriter::parseTerm(const std::string &firstDay, int weeks, Term &term) {
+    std::time_t time;
+    // A date that doesn't exist, e.g. "2023-02-30", would be read as a later one
+    if (weeks < 1 || !Auxiliar::parseTime(firstDay, time) || Auxiliar::formatTime(time).compare(0, 10, firstDay) != 0)
+        return false;
+    std::tm day{};
+    localtime_r(&time, &day);
+    term = {day.tm_year + 1900, day.tm_mon + 1, day.tm_mday, weeks};
+    return true;
+}
+
+/**
+ * @brief Writes a line of the document, folded in lines of up to 75 octets without splitting a UTF-8 character
+ * @param line
+ */
+void IcsWriter::writeLine(const std::string &line) {
+    const size_t MAX_OCTETS = 75;
+    size_t start = 0;
+    size_t width = MAX_OCTETS;
+    while (line.size() - start > width) {
+        size_t end = start + width;
+        while (end > start + 1 && (line[end] & 0xC0) == 0x80)
+            end--;
+        os.write(line.data() + start, end - start);
+        os << "\r\n ";          // The next line continues this one
+        start = end;
+        width = MAX_OCTETS - 1;
+    }
+    os.write(line.data() + start, line.size() - start);
+    os << "\r\n";
+}
+
+/**
+ * @brief Escapes the characters of a text value that have a meaning in iCalendar
+ * @param text
+ */
+std::string IcsWriter::escape(const std::string &text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '\\' || c == ';' || c == ',')
+            escaped += '\\';
+        if (c == '\n')
+            escaped += "\\n";
+        else
+            escaped += c;
+    }
+    return escaped;
+}
+
+/**
+ * @brief Writes a date as in iCalendar
+ * @param day
+ * @return e.g. "20231016"
+ */
+std::string IcsWriter::formatDate(const std::tm &day) {
+    std::ostringstream str;
+    str << std::put_time(&day, "%Y%m%d");
+    return str.str();
+}
+
+/**
+ * @brief Writes an hour of the day as in iCalendar
+ * @param hour e.g. 10.5
+ * @return e.g. "103000"
+ */
+std::string IcsWriter::formatTime(float hour) {
+    int minutes = (int) std::lround(hour * 60);
+    std::ostringstream str;
+    str << std::setfill('0') << std::setw(2) << minutes / 60 << std::setw(2) << minutes % 60 << "00";
+    return str.str();
+}
@@ -0,0 +1,64 @@
+#ifndef PROJETO_ICSWRITER_H
+#define PROJETO_ICSWRITER_H
+
+#include <ctime>
+#include <ostream>
+#include <string>
+#include "Schedule.h"
+#include "Timeslots.h"
+
+/**
+ * @brief IcsWriter writes schedules as an iCalendar (.ics) document that calendar clients import. Each weekly Lecture
+ * is one event that repeats every week of the term (RRULE), in local time. The document is written to the stream as it
+ * goes, a Lecture at a time, so a calendar of the whole course never has to fit in memory.
+ * @note Lines end in CRLF and are folded at 75 octets, like RFC 5545 requires
+ */
+
+class IcsWriter {
+public:
+    /**
+     * @brief Weeks the lectures repeat
+     */
+    struct Term {
+        int year;
+        int month;
+        int day;
+        int weeks;
+    };
+
+private:
+    std::ostream &os;
+    /**
+     * Date of the first day of the term with each weekday, e.g. "20231016"
+     */
+    std::string firstDates[Timeslots::DAYS];
+    /**
+     * Last moment of the term, e.g. "20240128T235959"
+     */
+    std::string until;
+    /**
+     * When the document was written, in UTC
+     */
+    std::string stamp;
+    size_t events;
+
+    void writeLine(const std::string &line);
+    static std::string escape(const std::string &text);
+    static std::string formatDate(const std::tm &day);
+    static std::string formatTime(float hour);
+
+public:
+    static const int DEFAULT_WEEKS = 15;
+
+    IcsWriter(std::ostream &os, const Term &term);
+    void begin(const std::string &name);
+    void writeLecture(const Lecture &lecture);
+    void writeSchedule(const Schedule &schedule);
+    void end();
+    size_t getEvents() const;
+    static Term currentTerm(int weeks = DEFAULT_WEEKS);
+    static bool parseTerm(const std::string &firstDay, int weeks, Term &term);
+};
+
+
+#endif //PROJETO_ICSWRITER_H
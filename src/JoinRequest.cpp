@@ -1,22 +1,40 @@
 #include <sstream>
 #include "JoinRequest.h"
+#include "LeaveRequest.h"
 
 /**
  * @brief Constructor of the JoinRequest
  * @param studentCode code of the student that requested
  * @param ucCode code of the UC which student wants to join
+ * @param classCode code of the Class to join, empty to let the Course choose it
  */
-JoinRequest::JoinRequest(std::string studentCode,std::string ucCode) : Request(studentCode),ucCode(ucCode)
+JoinRequest::JoinRequest(std::string studentCode,std::string ucCode,std::string classCode) : Request(std::move(studentCode)),ucCode(std::move(ucCode)),classCode(std::move(classCode))
 {}
 
 /**
  * @brief Gets the code of the UC to join
  * @return ucCode
  */
-std::string JoinRequest::getUcCode() const{
+const std::string& JoinRequest::getUcCode() const{
     return ucCode;
 }
 
+/**
+ * @brief Gets the code of the Class to join
+ * @return classCode, empty until the Course chooses it if it wasn't given
+ */
+const std::string& JoinRequest::getClassCode() const{
+    return classCode;
+}
+
+/**
+ * @brief Sets the code of the Class the Student joined, so that replaying the request gives the same Class
+ * @param classCode
+ */
+void JoinRequest::setClassCode(std::string classCode) {
+    this->classCode = std::move(classCode);
+}
+
 /**
  * @brief Auxiliar function to print after the JoinRequest is done
  */
@@ -26,3 +44,12 @@ std::string JoinRequest::toStr() const {
     return oss.str();
 }
 
+/**
+ * @brief Creates the request that undoes this one, leaving the UC joined
+ * @return new request marked as an undo, the caller takes ownership of it
+ */
+Request* JoinRequest::getUndoRequest() const {
+    Request *undoRequest = new LeaveRequest(getStudentCode(), ucCode);
+    undoRequest->setUndo();
+    return undoRequest;
+}
@@ -11,10 +11,14 @@ class JoinRequest : public Request{
 
 private:
     std::string ucCode;
+    std::string classCode;
 public:
-    JoinRequest(std::string studentCode,std::string ucCode);
-    std::string getUcCode()const;
+    JoinRequest(std::string studentCode,std::string ucCode,std::string classCode = "");
+    const std::string& getUcCode()const;
+    const std::string& getClassCode()const;
+    void setClassCode(std::string classCode);
     std::string toStr() const override;
+    Request* getUndoRequest() const override;
 };
 
 #endif //PROJETO_JOINREQUEST_H
@@ -1,18 +1,19 @@
 #include <sstream>
 #include "LeaveRequest.h"
+#include "JoinRequest.h"
 /**
  * @brief Constructor of the LeaveRequest
  * @param studentCode code of the student that requested
  * @param ucCode code of the UC which student wants to leave
  */
-LeaveRequest::LeaveRequest(std::string studentCode, std::string ucCode) : Request(studentCode), ucCode(ucCode)
+LeaveRequest::LeaveRequest(std::string studentCode, std::string ucCode) : Request(std::move(studentCode)), ucCode(std::move(ucCode))
 {}
 
 /**
  * @brief Gets the code of the UC to leave
  * @return ucCode
  */
-std::string LeaveRequest::getUcCode()const {
+const std::string& LeaveRequest::getUcCode()const {
     return ucCode;
 }
 
@@ -23,4 +24,14 @@ std::string LeaveRequest::toStr() const {
     std::ostringstream oss;
     oss << "Student " << getStudentCode() << " left UC " << ucCode;
     return oss.str();
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Creates the request that undoes this one, joining the UC left again
+ * @return new request marked as an undo, the caller takes ownership of it
+ */
+Request* LeaveRequest::getUndoRequest() const {
+    Request *undoRequest = new JoinRequest(getStudentCode(), ucCode);
+    undoRequest->setUndo();
+    return undoRequest;
+}
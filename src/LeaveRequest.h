@@ -13,8 +13,9 @@ private:
     std::string ucCode;
 public:
     LeaveRequest(std::string studentCode,std::string ucCode);
-    std::string getUcCode() const;
+    const std::string& getUcCode() const;
     std::string toStr() const override;
+    Request* getUndoRequest() const override;
 };
 
 #endif //PROJETO_LEAVEREQUEST_H
@@ -18,8 +18,8 @@ std::map<std::string, int> mapday =
  * @param duration Duration of the lecture
  * @param type Type of lecture
  */
-Lecture::Lecture(std::string classCode, std::string uc, std::string weekday, float startHour, float duration, std::string type):
-        classCode(classCode),ucCode(uc),weekday(mapday[weekday]), startHour(startHour),duration(duration),type(type){
+Lecture::Lecture(std::string classCode, std::string uc, const std::string &weekday, float startHour, float duration, std::string type):
+        classCode(std::move(classCode)),ucCode(std::move(uc)),weekday(mapday[weekday]), startHour(startHour),duration(duration),type(std::move(type)){
     this->endHour=startHour+duration;
 }
 
@@ -56,7 +56,7 @@ bool Lecture::operator<(const Lecture &lecture) const {
  * @brief Returns class code
  * @return class code
  */
-std::string Lecture::getClass() const {
+const std::string& Lecture::getClass() const {
     return classCode;
 }
 
@@ -64,7 +64,7 @@ std::string Lecture::getClass() const {
  * @brief Returns UC code
  * @return UC code
  */
-std::string Lecture::getUC() const {
+const std::string& Lecture::getUC() const {
     return ucCode;
 }
 
@@ -104,7 +104,7 @@ float Lecture::getDuration() const {
  * @brief Returns the type of lecture
  * @return type of lecture
  */
-std::string Lecture::getType() const {
+const std::string& Lecture::getType() const {
     return type;
 }
 
@@ -19,16 +19,16 @@ private:
     std::string type;
 
 public:
-    Lecture(std::string classCode, std::string ucCode, std::string weekday, float startHour, float duration, std::string type);
+    Lecture(std::string classCode, std::string ucCode, const std::string &weekday, float startHour, float duration, std::string type);
     bool operator<(const Lecture& lecture) const;
 
-    std::string getClass() const;
-    std::string getUC() const;
+    const std::string& getClass() const;
+    const std::string& getUC() const;
     int getWeekday() const;
     float getStartHour() const;
     float getEndHour() const;
     float getDuration() const;
-    std::string getType() const;
+    const std::string& getType() const;
     bool isOccurring(float hour) const;
     bool overlaps(const Lecture &lecture) const;
 };
@@ -0,0 +1,213 @@
+#include <iomanip>
+#include <algorithm>
+#include "Metrics.h"
+
+LatencyHistogram Metrics::histograms[Metrics::POINT_COUNT];
+std::atomic<uint64_t> Metrics::rejections[Request::REJECTION_COUNT];
+
+const char *Metrics::pointNames[Metrics::POINT_COUNT] = {
+        "load classes_per_uc", "load students_classes", "load classes", "load requests", "replay requests",
+        "assess Join", "assess Leave", "assess SwitchUc", "assess SwitchClass", "assess Join batch", "assess Switch batch",
+        "checkNumberUCs", "checkScheduleConflicts", "checkClassCap", "checkUcBalance",
+        "query UC's in year", "query classes in UC", "query student classes",
+        "query students in course", "query students in year", "query students in UC", "query students in class",
+        "query students in n UC's", "query student schedule", "query class schedule", "query UC schedule",
+        "query group availability", "query in session", "query class occupation", "query UC occupation", "query year occupation",
+        "query past course"
+};
+
+/**
+ * @brief Constructor of an empty LatencyHistogram
+ */
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+/**
+ * @brief Gets the bucket of a value. Values below 16 have a bucket each, the others share a bucket with the values
+ * that have the same 4 most significant bits.
+ * @param value
+ * @return bucket index
+ */
+int LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < SUB_BUCKETS)
+        return (int) value;
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - 4;
+    int bucket = SUB_BUCKETS + shift * SUB_BUCKETS + (int) ((value >> shift) - SUB_BUCKETS);
+    return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+/**
+ * @brief Gets the value in the middle of a bucket, used to report percentiles
+ * @param bucket
+ * @return value
+ */
+uint64_t LatencyHistogram::bucketMiddle(int bucket) {
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+    int shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t lower = (uint64_t) (SUB_BUCKETS + (bucket - SUB_BUCKETS) % SUB_BUCKETS) << shift;
+    return lower + (((uint64_t) 1 << shift) >> 1);
+}
+
+/**
+ * @brief Records a value
+ * @param value
+ */
+void LatencyHistogram::record(uint64_t value) {
+    buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t currentMax = max.load(std::memory_order_relaxed);
+    while (value > currentMax && !max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief Discards every value recorded
+ */
+void LatencyHistogram::reset() {
+    for (std::atomic<uint64_t> &bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of values recorded
+ */
+uint64_t LatencyHistogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the biggest value recorded
+ */
+uint64_t LatencyHistogram::getMax() const {
+    return max.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the mean of the values recorded
+ */
+double LatencyHistogram::getMean() const {
+    uint64_t n = getCount();
+    return n == 0 ? 0 : (double) sum.load(std::memory_order_relaxed) / n;
+}
+
+/**
+ * @brief Gets a percentile of the values recorded
+ * @param percentile between 0 and 100
+ * @return value below which percentile% of the values are
+ * @details Time Complexity O(n) n = number of buckets
+ */
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    uint64_t n = getCount();
+    if (n == 0)
+        return 0;
+    uint64_t target = (uint64_t) (percentile / 100 * n);
+    if (target == 0)
+        target = 1;
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= target)
+            return std::min(bucketMiddle(bucket), getMax());
+    }
+    return getMax();
+}
+
+/**
+ * @brief Checks if the instrumentation was compiled in (PROJETO_METRICS)
+ */
+bool Metrics::enabled() {
+#ifdef PROJETO_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Records the duration of a code path
+ * @param point
+ * @param nanoseconds
+ */
+void Metrics::record(Point point, uint64_t nanoseconds) {
+    histograms[point].record(nanoseconds);
+}
+
+/**
+ * @brief Counts one Request rejected
+ * @param rejection reason of the rejection
+ */
+void Metrics::countRejection(Request::Rejection rejection) {
+    rejections[rejection].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the latency histogram of a code path
+ * @param point
+ */
+const LatencyHistogram& Metrics::getHistogram(Point point) {
+    return histograms[point];
+}
+
+/**
+ * @brief Gets the name of a code path, as printed in the statistics
+ * @param point
+ */
+const char* Metrics::getPointName(Point point) {
+    return pointNames[point];
+}
+
+/**
+ * @brief Gets the number of Requests rejected for a reason
+ * @param rejection
+ */
+uint64_t Metrics::getRejections(Request::Rejection rejection) {
+    return rejections[rejection].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Discards every timer and counter
+ */
+void Metrics::reset() {
+    for (LatencyHistogram &histogram : histograms)
+        histogram.reset();
+    for (std::atomic<uint64_t> &counter : rejections)
+        counter.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Prints a table with the latencies (in microseconds) of the code paths that ran, and the number of requests rejected for each reason
+ * @param os
+ */
+void Metrics::print(std::ostream &os) {
+    if (!enabled()) {
+        os << "Statistics are not available, the program was built without PROJETO_METRICS.\n";
+        return;
+    }
+    os << std::left << std::setw(28) << "LATENCY (us)" << std::right << std::setw(10) << "count"
+       << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p90"
+       << std::setw(12) << "p99" << std::setw(12) << "max" << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (int point = 0; point < POINT_COUNT; point++) {
+        const LatencyHistogram &histogram = histograms[point];
+        if (histogram.getCount() == 0)
+            continue;
+        os << std::left << std::setw(28) << pointNames[point] << std::right << std::setw(10) << histogram.getCount()
+           << std::setw(12) << histogram.getMean() / 1000
+           << std::setw(12) << histogram.getPercentile(50) / 1000.0
+           << std::setw(12) << histogram.getPercentile(90) / 1000.0
+           << std::setw(12) << histogram.getPercentile(99) / 1000.0
+           << std::setw(12) << histogram.getMax() / 1000.0 << "\n";
+    }
+    os << "\n" << std::left << std::setw(28) << "REJECTIONS" << std::right << std::setw(10) << "count" << "\n";
+    for (int rejection = Request::ACCEPTED + 1; rejection < Request::REJECTION_COUNT; rejection++) {
+        os << std::left << std::setw(28) << Request::getRejectionName((Request::Rejection) rejection) << std::right
+           << std::setw(10) << rejections[rejection].load(std::memory_order_relaxed) << "\n";
+    }
+    os << std::defaultfloat;
+}
@@ -0,0 +1,109 @@
+#ifndef PROJETO_METRICS_H
+#define PROJETO_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include "Request.h"
+
+/**
+ * @brief Latency histogram with HDR-style log-linear buckets: every power of two is split in 16 buckets, so the
+ * values reported have a relative error below 1/16
+ * @details Time Complexity O(1) to record a value, thread-safe
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKETS = 16;
+    static const int BUCKETS = SUB_BUCKETS + 60 * SUB_BUCKETS;
+
+private:
+    std::atomic<uint64_t> buckets[BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+
+    static int bucketOf(uint64_t value);
+    static uint64_t bucketMiddle(int bucket);
+
+public:
+    LatencyHistogram();
+    void record(uint64_t value);
+    void reset();
+    uint64_t getCount() const;
+    uint64_t getMax() const;
+    double getMean() const;
+    uint64_t getPercentile(double percentile) const;
+};
+
+/**
+ * @brief Metrics stores the timers of the hot paths (loading, replaying, assessing requests and their checks, Terminal
+ * queries) and the number of requests rejected for each reason. Instrumentation is compiled in only when
+ * PROJETO_METRICS is defined, see METRICS_TIMER and METRICS_REJECTION.
+ */
+class Metrics {
+public:
+    /**
+     * @brief Timed code paths, each one has a latency histogram
+     */
+    enum Point {
+        LOAD_CLASSES_PER_UC, LOAD_STUDENTS_CLASSES, LOAD_CLASSES, LOAD_REQUESTS, REPLAY,
+        ASSESS_JOIN, ASSESS_LEAVE, ASSESS_SWITCH_UC, ASSESS_SWITCH_CLASS, ASSESS_JOIN_BATCH, ASSESS_SWITCH_CLASS_BATCH,
+        CHECK_NUMBER_UCS, CHECK_SCHEDULE_CONFLICTS, CHECK_CLASS_CAP, CHECK_UC_BALANCE,
+        QUERY_UCS_IN_YEAR, QUERY_CLASSES_IN_UC, QUERY_STUDENT_CLASSES,
+        QUERY_STUDENTS_IN_COURSE, QUERY_STUDENTS_IN_YEAR, QUERY_STUDENTS_IN_UC, QUERY_STUDENTS_IN_CLASS,
+        QUERY_STUDENTS_IN_AT_LEAST_UCS, QUERY_STUDENT_SCHEDULE, QUERY_CLASS_SCHEDULE, QUERY_UC_SCHEDULE,
+        QUERY_GROUP_AVAILABILITY, QUERY_IN_SESSION, QUERY_CLASS_OCCUPATION, QUERY_UC_OCCUPATION, QUERY_YEAR_OCCUPATION,
+        QUERY_HISTORY,
+        POINT_COUNT
+    };
+
+private:
+    static LatencyHistogram histograms[POINT_COUNT];
+    static std::atomic<uint64_t> rejections[Request::REJECTION_COUNT];
+    static const char *pointNames[POINT_COUNT];
+
+public:
+    static bool enabled();
+    static void record(Point point, uint64_t nanoseconds);
+    static void countRejection(Request::Rejection rejection);
+    static const LatencyHistogram& getHistogram(Point point);
+    static const char* getPointName(Point point);
+    static uint64_t getRejections(Request::Rejection rejection);
+    static void reset();
+    static void print(std::ostream &os);
+};
+
+/**
+ * @brief Records in Metrics the time between its construction and destruction
+ */
+class ScopedTimer {
+private:
+    Metrics::Point point;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(Metrics::Point point) : point(point), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        Metrics::record(point, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+};
+
+#define METRICS_CONCAT_(a, b) a##b
+#define METRICS_CONCAT(a, b) METRICS_CONCAT_(a, b)
+
+#ifdef PROJETO_METRICS
+/**
+ * Times the rest of the enclosing scope
+ */
+#define METRICS_TIMER(point) ScopedTimer METRICS_CONCAT(metricsTimer, __LINE__)(Metrics::point)
+/**
+ * Counts one Request rejected for a reason
+ */
+#define METRICS_REJECTION(rejection) Metrics::countRejection(rejection)
+#else
+#define METRICS_TIMER(point) ((void) 0)
+#define METRICS_REJECTION(rejection) ((void) 0)
+#endif
+
+#endif //PROJETO_METRICS_H
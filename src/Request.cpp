@@ -4,32 +4,120 @@
  * @brief Constructor of the Request
  * @param studentCode
  */
-Request::Request(std::string studentCode):studentCode(studentCode)
+Request::Request(std::string studentCode):studentCode(std::move(studentCode))
 {
+    rejection = ACCEPTED;
     undo = false;
+    time = 0;
 }
 /**
  * @brief Gets the code of the Student that requested
  * @return studentCode
  */
-std::string Request::getStudentCode() const {
+const std::string& Request::getStudentCode() const {
     return studentCode;
 }
 
 /**
- * @brief Gets the message of the Request
- * @return message
+ * @brief Gets the reason why the Request was rejected
+ * @return rejection, ACCEPTED if the Request wasn't rejected
+ */
+Request::Rejection Request::getRejection() const {
+    return rejection;
+}
+
+/**
+ * @brief Gets the code of the UC that caused the rejection
+ * @return rejectedUc, empty if the rejection doesn't refer to a UC
+ */
+const std::string& Request::getRejectedUc() const {
+    return rejectedUc;
+}
+
+/**
+ * @brief Gets the code of the Class that caused the rejection
+ * @return rejectedClass, empty if the rejection doesn't refer to a Class
+ */
+const std::string& Request::getRejectedClass() const {
+    return rejectedClass;
+}
+
+/**
+ * @brief Gets the code of the UC or Class the Student wanted to switch to, when the switch itself was invalid
+ * @return rejectedTarget
+ */
+const std::string& Request::getRejectedTarget() const {
+    return rejectedTarget;
+}
+
+/**
+ * @brief Rejects the Request, keeping only the reason and the codes involved. The message is built by getMessage, so
+ * the checks don't format strings for candidates that are discarded anyway.
+ * @param rejection reason
+ * @param ucCode UC that caused the rejection
+ * @param classCode Class that caused the rejection
+ * @param target UC or Class the Student wanted to switch to
+ */
+void Request::reject(Rejection rejection, const std::string &ucCode, const std::string &classCode, const std::string &target) {
+    this->rejection = rejection;
+    rejectedUc = ucCode;
+    rejectedClass = classCode;
+    rejectedTarget = target;
+}
+
+/**
+ * @brief Accepts a Request that was rejected before, e.g. a switch that was done later as part of a swap
+ */
+void Request::accept() {
+    rejection = ACCEPTED;
+    rejectedUc.clear();
+    rejectedClass.clear();
+    rejectedTarget.clear();
+}
+
+/**
+ * @brief Gets the message explaining why the Request was rejected
+ * @return message, empty if the Request wasn't rejected
  */
 std::string Request::getMessage() const {
-    return message;
+    switch (rejection) {
+        case STUDENT_NOT_FOUND:
+            return "Student " + studentCode + " is not registered in the course.\n";
+        case UC_NOT_FOUND:
+            return "UC " + rejectedUc + " does not exist.\n";
+        case CLASS_NOT_FOUND:
+            return "Class " + rejectedClass + " does not exist in UC " + rejectedUc + ".\n";
+        case INVALID_UC_SWITCH:
+            return "Can't switch from UC " + rejectedUc + " to UC " + rejectedTarget + ".\n";
+        case INVALID_CLASS_SWITCH:
+            return "Can't switch from class " + rejectedClass + " to class " + rejectedTarget + " in UC " + rejectedUc + ".\n";
+        case MAX_UCS:
+            return "Student is already registered in maximum number of UC's (7).\n";
+        case SCHEDULE_CONFLICT:
+            return "Can't join class " + rejectedClass + " since this class's schedule overlaps with the student's schedule.\n";
+        case CLASS_FULL:
+            return "Can't join class " + rejectedClass + " because it's full.\n";
+        case UC_BALANCE:
+            return "Can't switch to class " + rejectedClass + " because it disturbs the class occupation balance.\n";
+        case NOT_ENROLLED:
+            if (rejectedClass.empty())
+                return "Student is not registered in UC " + rejectedUc + ".\n";
+            return "Student is not registered in class " + rejectedClass + " of UC " + rejectedUc + ".\n";
+        default:
+            return "";
+    }
 }
 
 /**
- * @brief Sets the message of the Request
- * @param message
+ * @brief Gets a short name of a rejection reason, used in statistics and exports
+ * @param rejection
  */
-void Request::setMessage(std::string message) {
-    this->message=message;
+const char* Request::getRejectionName(Rejection rejection) {
+    static const char *names[REJECTION_COUNT] = {
+            "accepted", "student not found", "UC not found", "class not found", "invalid UC switch", "invalid class switch",
+            "maximum number of UC's", "schedule conflict", "class full", "class balance", "not enrolled"
+    };
+    return rejection < REJECTION_COUNT ? names[rejection] : "";
 }
 
 /**
@@ -46,4 +134,18 @@ bool Request::isUndo() const {
     return undo;
 }
 
+/**
+ * @brief Sets when the Request was done
+ * @param time
+ */
+void Request::setTime(std::time_t time) {
+    this->time = time;
+}
 
+/**
+ * @brief Gets when the Request was done
+ * @return time, 0 if it isn't known
+ */
+std::time_t Request::getTime() const {
+    return time;
+}
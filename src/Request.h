@@ -2,6 +2,7 @@
 #define PROJETO_REQUEST_H
 
 
+#include <ctime>
 #include <string>
 #include "Student.h"
 #include "Class.h"
@@ -12,20 +13,47 @@
  */
 
 class Request {
+public:
+    /**
+     * @brief Reason why a Request was rejected, ACCEPTED if it wasn't
+     */
+    enum Rejection {
+        ACCEPTED, STUDENT_NOT_FOUND, UC_NOT_FOUND, CLASS_NOT_FOUND, INVALID_UC_SWITCH, INVALID_CLASS_SWITCH,
+        MAX_UCS, SCHEDULE_CONFLICT, CLASS_FULL, UC_BALANCE, NOT_ENROLLED,
+        REJECTION_COUNT
+    };
+
 private:
 
     std::string studentCode;
-    std::string message;
+    Rejection rejection;
+    std::string rejectedUc;
+    std::string rejectedClass;
+    std::string rejectedTarget;
     bool undo;
+    /**
+     * When the Request was done, 0 if it isn't known (e.g. requests of histories written before the time was kept)
+     */
+    std::time_t time;
 
 public:
     Request(std::string studentCode);
-    std::string getStudentCode()const;
+    virtual ~Request() = default;
+    const std::string& getStudentCode()const;
+    Rejection getRejection() const;
+    const std::string& getRejectedUc() const;
+    const std::string& getRejectedClass() const;
+    const std::string& getRejectedTarget() const;
+    void accept();
+    void reject(Rejection rejection, const std::string &ucCode = "", const std::string &classCode = "", const std::string &target = "");
     std::string getMessage() const;
-    void setMessage(std::string message);
+    static const char* getRejectionName(Rejection rejection);
     void setUndo();
     bool isUndo() const;
+    void setTime(std::time_t time);
+    std::time_t getTime() const;
     virtual std::string toStr() const = 0;
+    virtual Request* getUndoRequest() const = 0;
 };
 
 
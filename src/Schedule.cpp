@@ -12,26 +12,40 @@ Schedule::Schedule() {}
  * @details Time Complexity O(log n) n= number of lectures in schedule
  */
 void Schedule::addLecture(Lecture lecture) {
-    schedule.insert(lecture);
+    busySlots |= Timeslots::getLectureSlots(lecture);
+    schedule.insert(std::move(lecture));
 }
 
 /**
- * @brief Removes a Lecture from the Schedule
+ * @brief Removes a Lecture from the Schedule. The busy slots are taken again from the remaining Lectures, since
+ * overlapping Lectures may share slots.
  * @param lecture
- * @details Time Complexity O(log n) n= number of lectures in schedule
+ * @details Time Complexity O(n) n= number of lectures in schedule
  */
-void Schedule::removeLecture(Lecture lecture) {
-    schedule.erase(lecture);
+void Schedule::removeLecture(const Lecture &lecture) {
+    if (schedule.erase(lecture) == 0)
+        return;
+    busySlots.reset();
+    for (const Lecture &remaining : schedule)
+        busySlots |= Timeslots::getLectureSlots(remaining);
 }
 
 /**
  * @brief Gets the Lectures of the Schedule
  * @return schedule
  */
-std::set<Lecture> Schedule::getLectures() const {
+const std::set<Lecture>& Schedule::getLectures() const {
     return schedule;
 }
 
+/**
+ * @brief Gets the half-hour slots of the week taken by at least one Lecture of the Schedule
+ * @return busySlots
+ */
+const Timeslots::Mask& Schedule::getBusySlots() const {
+    return busySlots;
+}
+
 /**
  * @brief Adds Lectures to the Schedule from other Schedule
  * @param schedule
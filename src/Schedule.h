@@ -4,6 +4,7 @@
 
 #include <set>
 #include "Lecture.h"
+#include "Timeslots.h"
 
 /**
  * @brief Schedule is the class that contains all the information of a schedule
@@ -13,12 +14,17 @@ class Schedule {
 
 private:
     std::set<Lecture> schedule;
+    /**
+     * Half-hour slots taken by at least one Lecture
+     */
+    Timeslots::Mask busySlots;
 
 public:
     Schedule();
-    void removeLecture(Lecture lecture);
+    void removeLecture(const Lecture &lecture);
     void addLecture(Lecture lecture);
-    std::set<Lecture> getLectures() const;
+    const std::set<Lecture>& getLectures() const;
+    const Timeslots::Mask& getBusySlots() const;
     void operator+=(const Schedule& schedule);
 };
 
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ScheduleExporter.h"
+#include "ScheduleLayout.h"
+#include "Terminal.h"
+#include "ThreadPool.h"
+#include "Timeslots.h"
+
+/**
+ * @brief Constructor of the ScheduleExporter
+ * @param course Course whose students are exported
+ * @param format format of the files
+ * @param directory where the files are written, one per student named after its code, created if it doesn't exist
+ * @param threads number of threads rendering and writing the schedules
+ */
+ScheduleExporter::ScheduleExporter(const Course &course, Format format, std::string directory, size_t threads)
+        : course(course), format(format), directory(std::move(directory)), threads(threads), term(IcsWriter::currentTerm()) {}
+
+/**
+ * @brief Sets the weeks of the calendars, the term starts on the Monday of the current week by default
+ * @param term
+ */
+void ScheduleExporter::setTerm(const IcsWriter::Term &term) {
+    this->term = term;
+}
+
+/**
+ * @brief Gets the format of the files from its name
+ * @param name "text", "csv" or "ics"
+ * @param format set to the format named
+ * @return false if the name isn't a format
+ */
+bool ScheduleExporter::parseFormat(const std::string &name, Format &format) {
+    if (name == "text")
+        format = TEXT;
+    else if (name == "csv")
+        format = CSV;
+    else if (name == "ics")
+        format = ICS;
+    else
+        return false;
+    return true;
+}
+
+/**
+ * @brief Writes the schedule of every student of the Course to a file. The students are split in tasks of
+ * STUDENTS_PER_TASK, which run on a ThreadPool.
+ * @return number of schedules and bytes written, files that failed and how long it took
+ * @details Time Complexity O(s * (l log l + g) / t) s = number of students, l = lectures of a student, g = cells of the
+ * table (text only), t = number of threads
+ */
+ScheduleExporter::Report ScheduleExporter::exportStudents() const {
+    auto start = std::chrono::steady_clock::now();
+    Report report;
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::vector<Student*> students = course.getStudentsInCourse();
+    {
+        ThreadPool pool(threads);
+        std::vector<std::future<Report>> parts;
+        for (size_t first = 0; first < students.size(); first += STUDENTS_PER_TASK) {
+            size_t last = std::min(first + STUDENTS_PER_TASK, students.size());
+            parts.push_back(pool.submit([this, &students, first, last]() { return exportStudents(students, first, last); }));
+        }
+        for (std::future<Report> &part : parts) {
+            Report done = part.get();
+            report.schedules += done.schedules;
+            report.failed += done.failed;
+            report.bytes += done.bytes;
+        }
+        report.threads = pool.size();
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+/**
+ * @brief Writes the calendar of the whole course, every Lecture of every UC, to course.ics. The calendar is written to
+ * the file a UC at a time, it is never whole in memory.
+ * @return one schedule written (or failed) with its size
+ * @details Time Complexity O(u + l) u = number of UC's, l = number of lectures
+ */
+ScheduleExporter::Report ScheduleExporter::exportCourse() const {
+    auto start = std::chrono::steady_clock::now();
+    Report report;
+    report.threads = 1;
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::ofstream file(directory + "/course.ics", std::ios::binary);
+    IcsWriter calendar(file, term);
+    calendar.begin("Schedule of " + course.getName());
+    for (const UC &uc : course.getUCsByCode())
+        calendar.writeSchedule(uc.getSchedule());
+    calendar.end();
+    file.flush();
+    if (file) {
+        report.schedules = 1;
+        report.bytes = file.tellp();
+    } else
+        report.failed = 1;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+/**
+ * @brief Writes the schedules of some of the students, a task of exportStudents
+ * @param students
+ * @param first index of the first student
+ * @param last index after the last student
+ * @return number of schedules and bytes written and of files that failed
+ */
+ScheduleExporter::Report ScheduleExporter::exportStudents(const std::vector<Student*> &students, size_t first, size_t last) const {
+    Report report;
+    const char *extension = format == TEXT ? ".txt" : format == CSV ? ".csv" : ".ics";
+    std::ostringstream buffer;
+    for (size_t i = first; i < last; i++) {
+        buffer.str("");
+        render(buffer, *students[i]);
+        std::string data = buffer.str();
+        if (writeFile(directory + "/" + students[i]->getStudentCode() + extension, data)) {
+            report.schedules++;
+            report.bytes += data.size();
+        } else
+            report.failed++;
+    }
+    return report;
+}
+
+/**
+ * @brief Renders the schedule of a student in the format of the export
+ * @param os
+ * @param student
+ */
+void ScheduleExporter::render(std::ostream &os, const Student &student) const {
+    if (format == TEXT) {
+        os << "This is the schedule of student " << student.getStudentCode() << " (" << student.getName() << ")\n\n";
+        Terminal::writeSchedule(os, ScheduleLayout(student.getSchedule()));
+        return;
+    }
+    if (format == ICS) {
+        IcsWriter calendar(os, term);
+        calendar.begin("Schedule of " + student.getName() + " (" + student.getStudentCode() + ")");
+        calendar.writeSchedule(student.getSchedule());
+        calendar.end();
+        return;
+    }
+    os << "weekday,start,end,uc,class,type\n";
+    for (const Lecture &lecture : student.getSchedule().getLectures()) {
+        os << Timeslots::getWeekdayName(lecture.getWeekday()) << "," << lecture.getStartHour() << "," << lecture.getEndHour()
+           << "," << lecture.getUC() << "," << lecture.getClass() << "," << lecture.getType() << "\n";
+    }
+}
+
+/**
+ * @brief Writes a file with a single write, replacing it if it exists
+ * @param path
+ * @param data
+ * @return false if the file couldn't be written
+ */
+bool ScheduleExporter::writeFile(const std::string &path, const std::string &data) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        written += n;
+    }
+    return close(fd) == 0 && written == data.size();
+}
+
+/**
+ * @brief Prints how many schedules were exported and how fast
+ * @param os
+ * @param report
+ */
+void ScheduleExporter::printReport(std::ostream &os, const Report &report) {
+    double seconds = std::max(report.seconds, 1e-9);
+    double megabytes = report.bytes / 1e6;
+    os << std::fixed << std::setprecision(2)
+       << "Exported " << report.schedules << " schedules (" << megabytes << " MB) in " << report.seconds << " s with "
+       << report.threads << " threads: " << std::setprecision(0) << report.schedules / seconds << " schedules/s, "
+       << std::setprecision(1) << megabytes / seconds << " MB/s\n";
+    if (report.failed > 0)
+        os << report.failed << " files couldn't be written\n";
+}
@@ -0,0 +1,67 @@
+#ifndef PROJETO_SCHEDULEEXPORTER_H
+#define PROJETO_SCHEDULEEXPORTER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Course.h"
+#include "IcsWriter.h"
+
+/**
+ * @brief ScheduleExporter writes the schedule of every student of the Course to a file of its own, e.g. to hand out the
+ * timetables at the start of the term. The schedules are rendered in parallel on a ThreadPool, as text (the table the
+ * Terminal prints), as CSV (a row per lecture, like the StudentSchedule command of BatchRunner) or as iCalendar (see
+ * IcsWriter), and each file is written at once from the buffer it was rendered to. The calendar of the whole course
+ * can be exported too.
+ * @note The Course must not change while it is exported
+ */
+
+class ScheduleExporter {
+public:
+    enum Format { TEXT, CSV, ICS };
+
+    /**
+     * @brief Result of an export
+     */
+    struct Report {
+        size_t schedules = 0;
+        /**
+         * Files that couldn't be written
+         */
+        size_t failed = 0;
+        uint64_t bytes = 0;
+        double seconds = 0;
+        size_t threads = 0;
+    };
+
+private:
+    const Course &course;
+    Format format;
+    std::string directory;
+    size_t threads;
+    /**
+     * Weeks of the calendars
+     */
+    IcsWriter::Term term;
+    /**
+     * Students rendered by each task of the ThreadPool
+     */
+    static const size_t STUDENTS_PER_TASK = 256;
+
+    Report exportStudents(const std::vector<Student*> &students, size_t first, size_t last) const;
+    void render(std::ostream &os, const Student &student) const;
+    static bool writeFile(const std::string &path, const std::string &data);
+
+public:
+    ScheduleExporter(const Course &course, Format format, std::string directory, size_t threads = std::thread::hardware_concurrency());
+    void setTerm(const IcsWriter::Term &term);
+    Report exportStudents() const;
+    Report exportCourse() const;
+    static bool parseFormat(const std::string &name, Format &format);
+    static void printReport(std::ostream &os, const Report &report);
+};
+
+
+#endif //PROJETO_SCHEDULEEXPORTER_H
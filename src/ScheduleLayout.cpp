@@ -0,0 +1,86 @@
+#include <cmath>
+#include <queue>
+#include "ScheduleLayout.h"
+
+/**
+ * @brief Constructor of an empty ScheduleLayout
+ */
+ScheduleLayout::ScheduleLayout() : grid(Timeslots::SLOTS, -1), lanes(Timeslots::DAYS, 0) {}
+
+/**
+ * @brief Constructor of the ScheduleLayout of a Schedule. The Lectures are bucketed by weekday in one pass and each
+ * weekday is colored in the order of the Schedule (start hour first): a Lecture takes the lowest lane free when it
+ * starts, so the first lane holds the Lectures that start while nothing else is being drawn.
+ * @param schedule
+ * @details Time Complexity O(n log n) n = number of lectures
+ */
+ScheduleLayout::ScheduleLayout(const Schedule &schedule) : ScheduleLayout() {
+    std::vector<std::vector<int>> byWeekday(Timeslots::DAYS);
+    for (const Lecture &lecture : schedule.getLectures()) {
+        int firstSlot = (int) std::floor((lecture.getStartHour() - Timeslots::FIRST_HOUR) * 2);
+        int endSlot = (int) std::ceil((lecture.getEndHour() - Timeslots::FIRST_HOUR) * 2);
+        placements.push_back({lecture, -1, firstSlot, endSlot - firstSlot});
+        // Lectures outside the grid can't be drawn
+        if (lecture.getWeekday() >= 0 && lecture.getWeekday() < Timeslots::DAYS && firstSlot >= 0 &&
+            endSlot <= Timeslots::SLOTS_PER_DAY && endSlot > firstSlot)
+            byWeekday[lecture.getWeekday()].push_back((int) placements.size() - 1);
+    }
+
+    using LaneEnd = std::pair<int, int>;        // (slot the lane is free again, lane)
+    for (int weekday = 0; weekday < Timeslots::DAYS; weekday++) {
+        std::priority_queue<LaneEnd, std::vector<LaneEnd>, std::greater<>> busy;
+        std::priority_queue<int, std::vector<int>, std::greater<>> free;
+        for (int index : byWeekday[weekday]) {
+            Placement &placement = placements[index];
+            while (!busy.empty() && busy.top().first <= placement.firstSlot) {
+                free.push(busy.top().second);
+                busy.pop();
+            }
+            if (free.empty())
+                placement.lane = lanes[weekday]++;
+            else {
+                placement.lane = free.top();
+                free.pop();
+            }
+            busy.push({placement.firstSlot + placement.slots, placement.lane});
+            if (placement.lane == 0) {
+                for (int slot = placement.firstSlot; slot < placement.firstSlot + placement.slots; slot++)
+                    grid[weekday * Timeslots::SLOTS_PER_DAY + slot] = index;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gets the Lecture drawn at a half hour of a weekday
+ * @param weekday
+ * @param slotOfDay half hour of the day, 0 is the first of the grid
+ * @return placement of the Lecture, nullptr if there is none
+ * @details Time Complexity O(1)
+ */
+const ScheduleLayout::Placement* ScheduleLayout::getPlacement(int weekday, int slotOfDay) const {
+    int index = grid[weekday * Timeslots::SLOTS_PER_DAY + slotOfDay];
+    return index == -1 ? nullptr : &placements[index];
+}
+
+/**
+ * @brief Gets the Lectures that aren't drawn in the grid, because they overlap a Lecture drawn or are outside the grid
+ * @return overlapped lectures
+ * @details Time Complexity O(n log n) n = number of lectures
+ */
+std::set<Lecture> ScheduleLayout::getOverlapped() const {
+    std::set<Lecture> overlapped;
+    for (const Placement &placement : placements) {
+        if (placement.lane != 0)
+            overlapped.insert(placement.lecture);
+    }
+    return overlapped;
+}
+
+/**
+ * @brief Gets the number of lanes needed to draw every Lecture of a weekday without overlaps
+ * @param weekday
+ */
+int ScheduleLayout::getLanes(int weekday) const {
+    return lanes[weekday];
+}
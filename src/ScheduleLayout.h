@@ -0,0 +1,53 @@
+#ifndef PROJETO_SCHEDULELAYOUT_H
+#define PROJETO_SCHEDULELAYOUT_H
+
+#include <vector>
+#include "Schedule.h"
+#include "Timeslots.h"
+
+/**
+ * @brief ScheduleLayout places the Lectures of a Schedule on the weekly grid (weekday x half hour) before it is printed.
+ * The overlapping Lectures of each weekday are split into lanes (interval coloring): the first lane is drawn in the grid
+ * and the Lectures of the other lanes are listed apart.
+ * @note The layout keeps copies of the Lectures, so it stays valid after the Schedule changes
+ */
+
+class ScheduleLayout {
+public:
+    /**
+     * @brief Lecture placed on the grid
+     */
+    struct Placement {
+        Lecture lecture;
+        /**
+         * Lane of the weekday, 0 is drawn in the grid. -1 if the Lecture is outside the grid.
+         */
+        int lane;
+        /**
+         * First half hour of the day the Lecture takes
+         */
+        int firstSlot;
+        /**
+         * Number of half hours the Lecture takes
+         */
+        int slots;
+    };
+
+private:
+    std::vector<Placement> placements;
+    /**
+     * Placement drawn at each slot of the week, -1 if none
+     */
+    std::vector<int> grid;
+    std::vector<int> lanes;
+
+public:
+    ScheduleLayout();
+    explicit ScheduleLayout(const Schedule &schedule);
+    const Placement* getPlacement(int weekday, int slotOfDay) const;
+    std::set<Lecture> getOverlapped() const;
+    int getLanes(int weekday) const;
+};
+
+
+#endif //PROJETO_SCHEDULELAYOUT_H
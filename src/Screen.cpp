@@ -0,0 +1,195 @@
+#include <cerrno>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "Screen.h"
+
+/**
+ * Moves the cursor home and clears the screen and the scrollback, the same as the clear program
+ */
+const std::string Screen::CLEAR = "\033[H\033[2J\033[3J";
+
+/**
+ * @brief Constructor of Screen, it starts buffering what is printed to the stream
+ * @param stream stream whose buffer is replaced, until the Screen is destroyed
+ * @param fd file descriptor the frames are written to
+ */
+Screen::Screen(std::ostream &stream, int fd) : stream(stream), fd(fd), written(0), clearPending(false),
+        interrupted(false), diffing(false) {
+    stream.flush();
+    previousBuffer = stream.rdbuf(this);
+}
+
+/**
+ * @brief Destructor of Screen, writes what is left of the frame and gives the stream its buffer back
+ */
+Screen::~Screen() {
+    sync();
+    stream.rdbuf(previousBuffer);
+}
+
+/**
+ * @brief Starts a new frame, the screen is cleared when the frame is written
+ */
+void Screen::clear() {
+    sync();
+    // Lines of the frame being replaced, to diff against. Only the last frame written at once can be diffed.
+    if (!clearPending) {
+        shownLines = interrupted ? std::vector<std::string>() : splitLines(frame);
+        // An unfinished last line (a prompt) is followed by what was typed, so it is always rewritten
+        if (!shownLines.empty() && frame.back() != '\n')
+            shownLines.pop_back();
+    }
+    frame.clear();
+    written = 0;
+    clearPending = true;
+    interrupted = false;
+}
+
+/**
+ * @brief Turns diffing frames on or off
+ * @param diffing
+ */
+void Screen::setDiffing(bool diffing) {
+    this->diffing = diffing;
+}
+
+/**
+ * @brief Appends a character to the frame
+ * @param c
+ */
+Screen::int_type Screen::overflow(int_type c) {
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+        frame.push_back(traits_type::to_char_type(c));
+    return traits_type::not_eof(c);
+}
+
+/**
+ * @brief Appends characters to the frame
+ * @param s
+ * @param n
+ */
+std::streamsize Screen::xsputn(const char *s, std::streamsize n) {
+    frame.append(s, n);
+    return n;
+}
+
+/**
+ * @brief Writes what wasn't written yet of the frame, with one write. If the frame starts a new screen, the screen is
+ * cleared first or only the lines that changed are rewritten.
+ * @return 0, or -1 if the write failed
+ */
+int Screen::sync() {
+    if (written == frame.size() && !clearPending)
+        return 0;
+    std::string data;
+    if (clearPending) {
+        std::vector<std::string> lines = splitLines(frame);
+        int rows = 0, columns = 0;
+        if (diffing && !shownLines.empty())
+            getTerminalSize(rows, columns);
+        // Both frames and the line echoed by the last read must fit, otherwise the terminal scrolled. A line as wide as
+        // the terminal wraps and takes more than one row.
+        if (rows > 0 && (int) shownLines.size() + 1 < rows && (int) lines.size() + 1 < rows
+            && fitsWidth(shownLines, columns) && fitsWidth(lines, columns))
+            data = diffFrame(lines);
+        else
+            data = CLEAR + frame;
+        clearPending = false;
+    }
+    else {
+        data = frame.substr(written);
+        if (written > 0)
+            interrupted = true;
+    }
+    written = frame.size();
+    return writeAll(data) ? 0 : -1;
+}
+
+/**
+ * @brief Builds the escape sequences that turn the lines shown into the new lines: each line that changed is rewritten
+ * in place and everything after the new frame is erased
+ * @param lines lines of the new frame, the last one may be unfinished (e.g. a prompt)
+ * @return data to write
+ * @details Time Complexity O(n) n = number of characters of both frames
+ */
+std::string Screen::diffFrame(const std::vector<std::string> &lines) const {
+    std::string data;
+    for (size_t line = 0; line < lines.size(); line++) {
+        if (line < shownLines.size() && lines[line] == shownLines[line])
+            continue;
+        data += "\033[" + std::to_string(line + 1) + ";1H" + lines[line] + "\033[K";
+    }
+    // Leave the cursor where the frame ends and erase what is below it
+    bool finished = frame.empty() || frame.back() == '\n';
+    size_t row = finished ? lines.size() + 1 : lines.size();
+    size_t column = finished ? 1 : lines.back().size() + 1;
+    data += "\033[" + std::to_string(row) + ";" + std::to_string(column) + "H\033[J";
+    return data;
+}
+
+/**
+ * @brief Splits a text into its lines, without the line breaks. An unfinished last line is also a line.
+ * @param text
+ */
+std::vector<std::string> Screen::splitLines(const std::string &text) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            lines.push_back(text.substr(start));
+            break;
+        }
+        lines.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return lines;
+}
+
+/**
+ * @brief Checks if every line is narrower than the terminal. The characters are counted in bytes, which is never less
+ * than the columns they take.
+ * @param lines
+ * @param columns columns of the terminal
+ * @details Time Complexity O(n) n = number of lines
+ */
+bool Screen::fitsWidth(const std::vector<std::string> &lines, int columns) {
+    for (const std::string &line : lines) {
+        if ((int) line.size() >= columns)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the size of the terminal
+ * @param rows set to the number of rows, 0 if the output isn't a terminal
+ * @param columns set to the number of columns, 0 if the output isn't a terminal
+ */
+void Screen::getTerminalSize(int &rows, int &columns) const {
+    winsize size{};
+    rows = columns = 0;
+    if (!isatty(fd) || ioctl(fd, TIOCGWINSZ, &size) != 0)
+        return;
+    rows = size.ws_row;
+    columns = size.ws_col;
+}
+
+/**
+ * @brief Writes all the data to the file descriptor, usually with a single write
+ * @param data
+ * @return true if all the data was written
+ */
+bool Screen::writeAll(const std::string &data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
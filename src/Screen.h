@@ -0,0 +1,59 @@
+#ifndef PROJETO_SCREEN_H
+#define PROJETO_SCREEN_H
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Screen takes the place of the buffer of an output stream (std::cout) so that everything printed to it is kept
+ * in memory as a frame. The frame is sent to the terminal with a single write when the stream is flushed, which
+ * std::cin does before every read. Screens are cleared with ANSI escape codes instead of running the clear program.
+ * @note When diffing is on and the terminal is tall and wide enough, a new frame only rewrites the lines that changed
+ * since the previous one
+ */
+
+class Screen : public std::streambuf {
+private:
+    std::ostream &stream;
+    std::streambuf *previousBuffer;
+    int fd;
+    std::string frame;
+    /**
+     * Characters of the frame already written
+     */
+    size_t written;
+    bool clearPending;
+    /**
+     * The frame was written in more than one piece, e.g. around a read, so the lines echoed by the terminal are mixed
+     * with it and can't be diffed
+     */
+    bool interrupted;
+    std::vector<std::string> shownLines;
+    bool diffing;
+
+    bool writeAll(const std::string &data);
+    std::string diffFrame(const std::vector<std::string> &lines) const;
+    static std::vector<std::string> splitLines(const std::string &text);
+    static bool fitsWidth(const std::vector<std::string> &lines, int columns);
+    void getTerminalSize(int &rows, int &columns) const;
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+    int sync() override;
+
+public:
+    static const std::string CLEAR;
+
+    explicit Screen(std::ostream &stream = std::cout, int fd = 1);
+    Screen(const Screen &screen) = delete;
+    Screen& operator=(const Screen &screen) = delete;
+    ~Screen() override;
+    void clear();
+    void setDiffing(bool diffing);
+};
+
+
+#endif //PROJETO_SCREEN_H
@@ -0,0 +1,282 @@
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Server.h"
+
+std::atomic<bool> Server::stopping(false);
+
+/**
+ * @brief Constructor of Server
+ * @param runner runs the commands, its Course is shared by every client
+ * @param socketPath path of the Unix domain socket
+ * @param threads number of commands run at the same time
+ */
+Server::Server(BatchRunner &runner, std::string socketPath, size_t threads) : runner(runner), socketPath(std::move(socketPath)),
+        version(0), pool(threads) {}
+
+/**
+ * @brief Signal handler that makes the Server stop accepting connections and finish
+ * @param signal
+ */
+void Server::stop(int signal) {
+    (void) signal;
+    stopping = true;
+}
+
+/**
+ * @brief Loads the requests previously made, serves the clients until SIGINT or SIGTERM, closes the connections open
+ * once the commands running are answered and saves the requests done.
+ * @return 0, or 1 if the socket couldn't be opened
+ */
+int Server::run() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << socketPath << "\n";
+        return 1;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketPath.c_str());         // Left behind by a server that didn't stop cleanly
+    if (listener < 0 || bind(listener, (sockaddr*) &address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "Can't listen on " << socketPath << ": " << std::strerror(errno) << "\n";
+        if (listener >= 0)
+            close(listener);
+        return 1;
+    }
+    if (pipe(wakeup) != 0) {
+        std::cerr << "Can't create a pipe: " << std::strerror(errno) << "\n";
+        close(listener);
+        unlink(socketPath.c_str());
+        return 1;
+    }
+
+    runner.load();
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        publish();
+    }
+    publisher = std::thread(&Server::publishChanges, this);
+    struct sigaction action{};
+    action.sa_handler = stop;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    std::cerr << "Listening on " << socketPath << " with " << pool.size() << " threads\n";
+
+    std::vector<pollfd> watched;
+    while (!stopping) {
+        watched.assign({{listener, POLLIN, 0}, {wakeup[0], POLLIN, 0}});
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            for (const auto &client : clients)
+                if (!client.second.closed && client.second.pending.size() < MAX_PENDING_LINES)
+                    watched.push_back({client.first, POLLIN, 0});
+        }
+        if (poll(watched.data(), watched.size(), 200) <= 0)
+            continue;
+        if (watched[1].revents != 0) {
+            char data[64];
+            read(wakeup[0], data, sizeof(data));
+        }
+        for (size_t i = 2; i < watched.size(); i++) {
+            if (watched[i].revents == 0)
+                continue;
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            receive(clients.at(watched[i].fd));
+        }
+        if (watched[0].revents != 0) {
+            int client = accept(listener, nullptr, nullptr);
+            if (client >= 0) {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                clients.emplace(client, Connection{client, "", {}, 0, 0, false, false});
+            }
+        }
+    }
+    close(listener);
+    unlink(socketPath.c_str());
+    changed.notify_all();
+    publisher.join();
+
+    // The lines not started are dropped, the connections running one close once it is answered
+    {
+        std::unique_lock<std::mutex> lock(clientsMutex);
+        for (auto it = clients.begin(); it != clients.end(); ) {
+            Connection &connection = (it++)->second;
+            connection.pending.clear();
+            connection.closed = true;
+            if (connection.busy)
+                shutdown(connection.fd, SHUT_RDWR);     // Wakes up a send to a client that isn't reading
+            else
+                closeConnection(connection);
+        }
+        clientsClosed.wait(lock, [this]() { return clients.empty(); });
+    }
+    close(wakeup[0]);
+    close(wakeup[1]);
+    runner.save();
+    return 0;
+}
+
+/**
+ * @brief Reads what a client sent and queues its complete lines, handing the first one to the pool if none of its lines
+ * is running. Must be called with clientsMutex.
+ * @param connection connection with data to read or closed by the client
+ */
+void Server::receive(Connection &connection) {
+    char data[4096];
+    ssize_t n = read(connection.fd, data, sizeof(data));
+    if (n < 0 && errno == EINTR)
+        return;
+    if (n <= 0) {
+        connection.closed = true;
+        if (!connection.busy)
+            closeConnection(connection);
+        return;
+    }
+    connection.buffer.append(data, n);
+    size_t start = 0, end;
+    while ((end = connection.buffer.find('\n', start)) != std::string::npos) {
+        connection.pending.push_back(connection.buffer.substr(start, end - start));
+        start = end + 1;
+    }
+    connection.buffer.erase(0, start);
+    if (!connection.busy && !connection.pending.empty()) {
+        connection.busy = true;
+        Connection *running = &connection;
+        pool.submit([this, running]() { runNext(running); });
+    }
+}
+
+/**
+ * @brief Runs the first line waiting of a connection, then hands the next one to the pool, so that the other clients
+ * get their turn, or closes the connection if the client closed it and nothing is left to answer
+ * @param connection connection with a line waiting, marked busy
+ */
+void Server::runNext(Connection *connection) {
+    std::string line;
+    int lineNumber;
+    bool throttled;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        if (connection->pending.empty()) {      // Dropped when the Server stopped
+            connection->busy = false;
+            closeConnection(*connection);
+            return;
+        }
+        throttled = connection->pending.size() >= MAX_PENDING_LINES;
+        line = std::move(connection->pending.front());
+        connection->pending.pop_front();
+        lineNumber = ++connection->lineNumber;
+    }
+    respond(connection->fd, std::move(line), lineNumber, connection->lastWrite);
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    if (!connection->pending.empty())
+        pool.submit([this, connection]() { runNext(connection); });
+    else {
+        connection->busy = false;
+        if (connection->closed)
+            closeConnection(*connection);
+    }
+    if (throttled)
+        write(wakeup[1], "", 1);
+}
+
+/**
+ * @brief Closes the socket of a connection and forgets it. Must be called with clientsMutex, on a connection not busy.
+ * @param connection
+ */
+void Server::closeConnection(Connection &connection) {
+    int fd = connection.fd;
+    close(fd);
+    clients.erase(fd);
+    clientsClosed.notify_all();
+}
+
+/**
+ * @brief Runs a command of a client and sends its result. The commands that change the Course run one at a time, the
+ * consults read the latest snapshot.
+ * @param client
+ * @param line command
+ * @param lineNumber number of the command in the connection
+ * @param lastWrite version of the last change done by the client, so that its consults see its own requests
+ */
+void Server::respond(int client, std::string line, int lineNumber, unsigned long &lastWrite) {
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+    std::ostringstream result;
+    if (BatchRunner::changesCourse(line)) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        runner.runCommand(line, lineNumber, result);
+        lastWrite = ++version;
+        changed.notify_one();
+    }
+    else {
+        std::shared_ptr<const Snapshot> view = std::atomic_load(&snapshot);
+        if (view->version < lastWrite) {
+            // A change of this client wasn't published yet, consults the Course itself like a request would
+            std::lock_guard<std::mutex> lock(writeMutex);
+            runner.runCommand(line, lineNumber, result);
+        }
+        else
+            runner.runCommand(line, lineNumber, result, view->course.get());
+    }
+    sendAll(client, result.str());
+}
+
+/**
+ * @brief Publishes a copy of the Course as the latest snapshot, if it changed since the last one. Must be called with
+ * writeMutex.
+ * @details Time Complexity O(Course::clone), the consults running keep the snapshot they started with
+ */
+void Server::publish() {
+    std::shared_ptr<const Snapshot> latest = std::atomic_load(&snapshot);
+    if (latest != nullptr && latest->version == version)
+        return;
+    std::atomic_store(&snapshot, std::shared_ptr<const Snapshot>(new Snapshot{runner.getCourse().clone(), version}));
+}
+
+/**
+ * @brief Loop of the publisher thread: when the Course changes, publishes a snapshot with every change done until then,
+ * and waits PUBLISH_INTERVAL_MS before publishing again
+ */
+void Server::publishChanges() {
+    std::unique_lock<std::mutex> lock(writeMutex);
+    while (!stopping) {
+        bool stale = changed.wait_for(lock, std::chrono::milliseconds(200), [this]() {
+            return stopping || std::atomic_load(&snapshot)->version != version;
+        });
+        if (!stale || stopping)
+            continue;
+        publish();
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(PUBLISH_INTERVAL_MS));
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Sends all the data through a socket
+ * @param fd
+ * @param data
+ * @return false if the connection was closed
+ */
+bool Server::sendAll(int fd, const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        sent += n;
+    }
+    return true;
+}
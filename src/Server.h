@@ -0,0 +1,129 @@
+#ifndef PROJETO_SERVER_H
+#define PROJETO_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "BatchRunner.h"
+#include "ThreadPool.h"
+
+/**
+ * @brief Server lets many clients consult and change the same Course at once, through a Unix domain socket. The
+ * protocol is the one of BatchRunner: each line a client sends is a command and gets a line back with its result in
+ * JSON Lines (empty lines and comments get no answer). The commands that change the Course (requests, files of
+ * requests and undos) run one at a time. A publisher thread then copies the Course (Course::clone) into an immutable
+ * snapshot that has every change done so far. Consults read the latest snapshot, so they run at the same time on a
+ * ThreadPool and never wait for the requests, and the requests never wait for them. A client always sees its own
+ * requests: until they are published, its consults run on the Course itself, one at a time with the requests. The
+ * request history and the waitlist are loaded when the Server starts and saved when it stops (SIGINT or SIGTERM), so
+ * clients never overwrite each other's requests.
+ * @note One thread watches every connection with poll and hands each line received to the pool, after the lines the
+ * same client sent before it are answered. The number of threads limits the commands running at the same time, not the
+ * connections open.
+ */
+
+class Server {
+private:
+    /**
+     * Minimum time between two snapshots, while the Course keeps changing, so that the copies don't keep the requests
+     * waiting. The changes done meanwhile are published together.
+     */
+    static constexpr int PUBLISH_INTERVAL_MS = 100;
+    /**
+     * Number of lines of a client waiting to run beyond which its connection isn't read, until some of them are answered
+     */
+    static constexpr size_t MAX_PENDING_LINES = 64;
+
+    BatchRunner &runner;
+    std::string socketPath;
+    /**
+     * @brief Immutable copy of the Course, with the number of changes done when it was made
+     */
+    struct Snapshot {
+        std::unique_ptr<const Course> course;
+        unsigned long version;
+    };
+
+    /**
+     * @brief Taken by the commands that change the Course, one at a time
+     */
+    std::mutex writeMutex;
+    /**
+     * @brief Number of commands that changed the Course, guarded by writeMutex
+     */
+    unsigned long version;
+    /**
+     * @brief Notified when the Course changes, wakes up the publisher
+     */
+    std::condition_variable changed;
+    std::thread publisher;
+    /**
+     * @brief Latest snapshot, read and replaced only with std::atomic_load and std::atomic_store. A snapshot is freed
+     * when the last consult using it finishes.
+     */
+    std::shared_ptr<const Snapshot> snapshot;
+    /**
+     * @brief Connection of a client. At most one of its lines runs at a time, so they are answered in order.
+     */
+    struct Connection {
+        int fd;
+        /**
+         * @brief Data received after the last complete line
+         */
+        std::string buffer;
+        /**
+         * @brief Complete lines waiting to run
+         */
+        std::deque<std::string> pending;
+        int lineNumber;
+        /**
+         * @brief Version of the last change done by the client, so that its consults see its own requests
+         */
+        unsigned long lastWrite;
+        /**
+         * @brief A line of the connection was handed to the pool and isn't answered yet
+         */
+        bool busy;
+        /**
+         * @brief The client closed the connection, it is closed here once its lines are answered
+         */
+        bool closed;
+    };
+
+    std::mutex clientsMutex;
+    /**
+     * @brief Connections open by socket, guarded by clientsMutex
+     */
+    std::map<int, Connection> clients;
+    std::condition_variable clientsClosed;
+    /**
+     * @brief Pipe written when a connection may be read again, to wake up the poll
+     */
+    int wakeup[2];
+    /**
+     * @brief Declared last, so that its threads finish before the rest of the Server is destroyed
+     */
+    ThreadPool pool;
+    static std::atomic<bool> stopping;
+
+    void receive(Connection &connection);
+    void runNext(Connection *connection);
+    void closeConnection(Connection &connection);
+    void respond(int client, std::string line, int lineNumber, unsigned long &lastWrite);
+    void publish();
+    void publishChanges();
+    static bool sendAll(int fd, const std::string &data);
+    static void stop(int signal);
+
+public:
+    Server(BatchRunner &runner, std::string socketPath, size_t threads = std::thread::hardware_concurrency());
+    int run();
+};
+
+
+#endif //PROJETO_SERVER_H
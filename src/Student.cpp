@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "Student.h"
 
 /**
@@ -5,25 +6,25 @@
  * @param studentCode
  * @param studentName
  */
-Student::Student(std::string studentCode, std::string studentName): studentCode(studentCode), name(studentName){}
+Student::Student(std::string studentCode, std::string studentName): name(std::move(studentName)), studentCode(std::move(studentCode)){}
 
 /**
  * @brief Gets the name of Student
  * @return name
  */
-std::string Student::getName() const{ return name;}
+const std::string& Student::getName() const{ return name;}
 
 /**
  * @brief Gets the code of Student
  * @return studentCode
  */
-std::string Student::getStudentCode() const{return studentCode;}
+const std::string& Student::getStudentCode() const{return studentCode;}
 
 /**
  * @brief Gets the Schedule of Student
  * @return schedule
  */
-Schedule Student::getSchedule() const {
+const Schedule& Student::getSchedule() const {
     return schedule;
 }
 
@@ -66,15 +67,46 @@ bool Student::operator==(const Student &other) const {
  * @details Time Complexity O(log n) n = number of Lectures in schedule
  */
 void Student::addLecture(Lecture newLecture) {
-    schedule.addLecture(newLecture);
+    schedule.addLecture(std::move(newLecture));
 }
 
 /**
  * @brief Removes Lecture from Student Schedule
  * @param lecture
- * @details Time Complexity O(log n) n = number of Lectures in schedule
+ * @details Time Complexity O(n) n = number of Lectures in schedule
  */
 void Student::removeLecture(const Lecture &lecture) {
     schedule.removeLecture(lecture);
 }
 
+/**
+ * @brief Gets the indexes of the Classes the Student is in
+ * @return classIndexes
+ */
+const std::vector<int>& Student::getClassIndexes() const {
+    return classIndexes;
+}
+
+/**
+ * @brief Adds a Class to the Classes the Student is in
+ * @param index index of the Class, ignored if it is negative or the Student is already in it
+ * @details Time Complexity O(n) n = number of Classes of the Student
+ */
+void Student::joinClass(int index) {
+    if (index >= 0 && std::find(classIndexes.begin(), classIndexes.end(), index) == classIndexes.end())
+        classIndexes.push_back(index);
+}
+
+/**
+ * @brief Removes a Class from the Classes the Student is in
+ * @param index index of the Class
+ * @return true if the Student was in the Class
+ * @details Time Complexity O(n) n = number of Classes of the Student
+ */
+bool Student::leaveClass(int index) {
+    auto class_ = std::find(classIndexes.begin(), classIndexes.end(), index);
+    if (class_ == classIndexes.end())
+        return false;
+    classIndexes.erase(class_);
+    return true;
+}
@@ -1,6 +1,7 @@
 #ifndef PROJETO_STUDENT_H
 #define PROJETO_STUDENT_H
 
+#include <vector>
 #include "Schedule.h"
 
 /**
@@ -12,16 +13,22 @@ private:
     std::string name;
     std::string studentCode;
     Schedule schedule;
-
+    /**
+     * Indexes of the Classes the Student is in
+     */
+    std::vector<int> classIndexes;
 
 public:
     Student(std::string studentCode, std::string studentName);
-    std::string getName() const;
-    std::string getStudentCode() const;
-    Schedule getSchedule() const;
+    const std::string& getName() const;
+    const std::string& getStudentCode() const;
+    const Schedule& getSchedule() const;
     int getNumberUcs();
     void addLecture(Lecture newLecture);
     void removeLecture(const Lecture &lecture);
+    const std::vector<int>& getClassIndexes() const;
+    void joinClass(int index);
+    bool leaveClass(int index);
     bool operator<(const Student& student) const;
     bool operator==(const Student& other) const;  // Able to use find method, student is equal if it has same studentcode
 };
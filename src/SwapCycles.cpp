@@ -0,0 +1,77 @@
+#include <cstddef>
+#include "SwapCycles.h"
+
+/**
+ * @brief Constructor of a SwapCycles without switches
+ * @param classes number of Classes of the UC
+ */
+SwapCycles::SwapCycles(int classes) : outgoing(classes) {}
+
+/**
+ * @brief Adds a pending switch
+ * @param from index of the Class the student leaves
+ * @param to index of the Class the student joins
+ * @return index of the switch
+ */
+int SwapCycles::addSwitch(int from, int to) {
+    targets.push_back(to);
+    outgoing[from].push_back((int) targets.size() - 1);
+    return (int) targets.size() - 1;
+}
+
+/**
+ * @brief Finds disjoint cycles of switches (each switch is used at most once), 2-swaps and longer chains alike.
+ * A walk follows unused switches, and when it reaches a Class already on the walk the switches since then form a
+ * cycle, are taken out and the walk goes on from that Class. A Class with no unused switches left is a dead end for
+ * good, so every switch is looked at a constant number of times.
+ * @return switches of each cycle, in the order they are followed
+ * @details Time Complexity O(V + E) V = number of classes, E = number of switches
+ */
+std::vector<std::vector<int>> SwapCycles::findCycles() const {
+    int classes = (int) outgoing.size();
+    std::vector<std::vector<int>> cycles;
+    std::vector<size_t> nextSwitch(classes, 0);
+    std::vector<bool> dead(classes, false);
+    std::vector<int> positionOnPath(classes, -1);
+    std::vector<int> pathClasses;
+    std::vector<int> pathSwitches;
+
+    for (int start = 0; start < classes; start++) {
+        if (dead[start])
+            continue;
+        pathClasses = {start};
+        positionOnPath[start] = 0;
+        while (!pathClasses.empty()) {
+            int current = pathClasses.back();
+            // Skip the switches that lead to dead ends
+            while (nextSwitch[current] < outgoing[current].size() && dead[targets[outgoing[current][nextSwitch[current]]]])
+                nextSwitch[current]++;
+            if (nextSwitch[current] == outgoing[current].size()) {
+                dead[current] = true;
+                positionOnPath[current] = -1;
+                pathClasses.pop_back();
+                if (!pathSwitches.empty())
+                    pathSwitches.pop_back();
+                continue;
+            }
+            int switch_ = outgoing[current][nextSwitch[current]++];
+            int next = targets[switch_];
+            if (positionOnPath[next] == -1) {
+                positionOnPath[next] = (int) pathClasses.size();
+                pathClasses.push_back(next);
+                pathSwitches.push_back(switch_);
+                continue;
+            }
+            // Cycle from next back to next, the walk goes on from next
+            int position = positionOnPath[next];
+            std::vector<int> cycle(pathSwitches.begin() + position, pathSwitches.end());
+            cycle.push_back(switch_);
+            cycles.push_back(std::move(cycle));
+            for (size_t i = position + 1; i < pathClasses.size(); i++)
+                positionOnPath[pathClasses[i]] = -1;
+            pathClasses.resize(position + 1);
+            pathSwitches.resize(position);
+        }
+    }
+    return cycles;
+}
@@ -0,0 +1,25 @@
+#ifndef PROJETO_SWAPCYCLES_H
+#define PROJETO_SWAPCYCLES_H
+
+#include <vector>
+
+/**
+ * @brief SwapCycles finds cycles in the directed graph of pending class switches of a UC (an arc from the current Class
+ * to the next Class of each switch). The switches of a cycle can be done together without changing the occupation of
+ * any Class, so neither the capacity nor the balance of the UC are affected.
+ * @note Classes and switches are identified by their index, in the order they were added
+ */
+
+class SwapCycles {
+private:
+    std::vector<std::vector<int>> outgoing;
+    std::vector<int> targets;
+
+public:
+    explicit SwapCycles(int classes);
+    int addSwitch(int from, int to);
+    std::vector<std::vector<int>> findCycles() const;
+};
+
+
+#endif //PROJETO_SWAPCYCLES_H
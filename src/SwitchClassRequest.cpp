@@ -9,13 +9,13 @@
  * @param classCodeNext
  */
 SwitchClassRequest::SwitchClassRequest(std::string studentCode, std::string ucCode, std::string classCodeCurrent,std::string classCodeNext)
-: Request(studentCode),ucCode(ucCode),classCodeCurrent(classCodeCurrent),classCodeNext(classCodeNext){}
+: Request(std::move(studentCode)),ucCode(std::move(ucCode)),classCodeCurrent(std::move(classCodeCurrent)),classCodeNext(std::move(classCodeNext)){}
 
 /**
  * @brief Gets the code of the UC which classes are registered
  * @return ucCode
  */
-std::string SwitchClassRequest::getUcCode() const{
+const std::string& SwitchClassRequest::getUcCode() const{
     return ucCode;
 }
 
@@ -23,7 +23,7 @@ std::string SwitchClassRequest::getUcCode() const{
  * @brief Get the code of the Class which the student is currently registered
  * @return classCodeCurrent
  */
-std::string SwitchClassRequest::getClassCodeCurrent() const{
+const std::string& SwitchClassRequest::getClassCodeCurrent() const{
     return classCodeCurrent;
 }
 
@@ -31,7 +31,7 @@ std::string SwitchClassRequest::getClassCodeCurrent() const{
  * @brief Gets the code of the Class which the student wants to switch
  * @return classCodeNext
  */
-std::string SwitchClassRequest::getClassCodeNext() const{
+const std::string& SwitchClassRequest::getClassCodeNext() const{
     return classCodeNext;
 }
 /**
@@ -43,3 +43,12 @@ std::string SwitchClassRequest::toStr() const {
     return oss.str();
 }
 
+/**
+ * @brief Creates the request that undoes this one, switching back to the class left
+ * @return new request marked as an undo, the caller takes ownership of it
+ */
+Request* SwitchClassRequest::getUndoRequest() const {
+    Request *undoRequest = new SwitchClassRequest(getStudentCode(), ucCode, classCodeNext, classCodeCurrent);
+    undoRequest->setUndo();
+    return undoRequest;
+}
@@ -17,10 +17,11 @@ private:
 
 public:
     SwitchClassRequest(std::string studentCode,std::string ucCode,std::string classCodeCurrent, std::string classCodeNext);
-    std::string getUcCode() const;
-    std::string getClassCodeCurrent() const;
-    std::string getClassCodeNext() const;
+    const std::string& getUcCode() const;
+    const std::string& getClassCodeCurrent() const;
+    const std::string& getClassCodeNext() const;
     std::string toStr() const override;
+    Request* getUndoRequest() const override;
 };
 
 
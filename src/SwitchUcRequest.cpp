@@ -8,13 +8,13 @@
  * @param ucCodeNext
  */
 SwitchUcRequest::SwitchUcRequest(std::string studentCode, std::string ucCodeCurrent, std::string ucCodeNext)
-: Request(studentCode),ucCodeCurrent(ucCodeCurrent),ucCodeNext(ucCodeNext){}
+: Request(std::move(studentCode)),ucCodeCurrent(std::move(ucCodeCurrent)),ucCodeNext(std::move(ucCodeNext)){}
 
 /**
  * @brief Gets the code of the UC which the student is currently registered
  * @return ucCodeCurrent
  */
-std::string SwitchUcRequest::getUcCodeCurrent() const{
+const std::string& SwitchUcRequest::getUcCodeCurrent() const{
     return ucCodeCurrent;
 }
 
@@ -22,7 +22,7 @@ std::string SwitchUcRequest::getUcCodeCurrent() const{
  * @brief Gets the code of the UC which the student wants to switch
  * @return ucCodeNext
  */
-std::string SwitchUcRequest::getUcCodeNext() const{
+const std::string& SwitchUcRequest::getUcCodeNext() const{
     return ucCodeNext;
 }
 
@@ -35,3 +35,12 @@ std::string SwitchUcRequest::toStr() const {
     return oss.str();
 }
 
+/**
+ * @brief Creates the request that undoes this one, switching back to the UC left
+ * @return new request marked as an undo, the caller takes ownership of it
+ */
+Request* SwitchUcRequest::getUndoRequest() const {
+    Request *undoRequest = new SwitchUcRequest(getStudentCode(), ucCodeNext, ucCodeCurrent);
+    undoRequest->setUndo();
+    return undoRequest;
+}
@@ -15,9 +15,10 @@ private:
 
 public:
     SwitchUcRequest(std::string studentCode,std::string ucCodeCurrent,std::string ucCodeNext);
-    std::string getUcCodeCurrent() const;
-    std::string getUcCodeNext() const;
+    const std::string& getUcCodeCurrent() const;
+    const std::string& getUcCodeNext() const;
     std::string toStr() const override;
+    Request* getUndoRequest() const override;
 };
 
 
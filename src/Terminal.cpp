@@ -6,14 +6,15 @@
 #include <utility>
 #include "Terminal.h"
 #include "Auxiliar.h"
+#include "Metrics.h"
 
 /**
- * @brief Constructor of the Terminal class. Stores the course in the private field so that it can communicate
- * with the course throughout the program.
+ * @brief Constructor of the Terminal class. Takes over the course, so that it can communicate with the course throughout
+ * the program without keeping a second copy of it. Screens are diffed against the previous one when possible.
  * @param course Course being managed by the Terminal
  */
-Terminal::Terminal(const Course &course) {
-    this->course = course;
+Terminal::Terminal(Course &&course) : course(std::move(course)), pastCourseRequests(0), watcher(this->course) {
+    screen.setDiffing(true);
 }
 
 /**
@@ -29,16 +30,28 @@ Terminal::~Terminal() {
 
 /**
  * @brief This method is called to start the interface. Loads the requests previously made, redoes them, starts the interface
- * and before returning saves the requests done.
+ * and before returning saves the requests done. The waitlist is saved next to the request history.
  */
 void Terminal::run(){
     Auxiliar::loadRequestRecord(pastRequests);
     redoPastRequests();
-    system("clear");
+    // The requests taken from the waitlist are already in the history, so the seats freed while redoing are not given again
+    course.takeFreedSeats();
+    std::queue<Request*> waiting;
+    Auxiliar::loadRequestRecord(waiting, "../waitlist.txt");
+    while (!waiting.empty()) {
+        if (waitlist.add(waiting.front()) == 0)
+            delete waiting.front();
+        waiting.pop();
+    }
+    screen.clear();
     printMainMenu();
-    system("clear");
+    screen.clear();
     Auxiliar::saveRequestRecord(requestRecord);
-    system("clear");
+    Auxiliar::saveRequests(waitlist.getRequests(), "../waitlist.txt");
+    screen.clear();
+    if (Metrics::enabled())
+        Metrics::print(std::cout);
 }
 
 
@@ -46,20 +59,45 @@ void Terminal::run(){
  * @brief Redoes the past requests in chronological order.
  */
 void Terminal::redoPastRequests() {
+    std::vector<Request*> requests;
     while (!pastRequests.empty()) {
-        course.assessRequest(pastRequests.front());
+        requests.push_back(pastRequests.front());
         requestRecord.push(pastRequests.front());
         pastRequests.pop();
     }
+    history.replay(course, requests);
+}
+
+/**
+ * @brief Gets the Course the consults read: the Course as it was after a past request, if one is being consulted, or
+ * the present one
+ */
+const Course& Terminal::consulted() const {
+    return pastCourse != nullptr ? *pastCourse : course;
+}
+
+/**
+ * @brief Applies the rows of the data files changed since the last check to the course, without waiting, and prints
+ * what changed. The past courses consulted keep the timetable they were built with.
+ */
+void Terminal::reloadData() {
+    DataWatcher::Report report;
+    if (watcher.poll(report)) {
+        DataWatcher::printReport(std::cout, report);
+        std::cout << "\n";
+    }
 }
 
 /**
  * @brief Prints the main menu.
  */
 void Terminal::printMainMenu() {
-    system("clear");
-    std::cout << center("SCHEDULE LEIC", '*', MENU_WIDTH) << "\n\n"
-    << center("CONSULTS", ' ', MENU_WIDTH) << "\n"
+    screen.clear();
+    std::cout << center("SCHEDULE LEIC", '*', MENU_WIDTH) << "\n\n";
+    reloadData();
+    if (pastCourse != nullptr)
+        printPastCourse();
+    std::cout << center("CONSULTS", ' ', MENU_WIDTH) << "\n"
     << "\t0 - Consult the UC's of a year" << "\n"
     << "\t1 - Consult the classes of a UC" << "\n"
     << "\t2 - Consult the classes of a student" << "\n"
@@ -78,9 +116,19 @@ void Terminal::printMainMenu() {
     << "\t12 - Request to join a UC" << "\n"
     << "\t13 - Request to leave a UC" << "\n"
     << "\t14 - Request a UC switch" << "\n"
-    << "\t15 - Request a class switch" << "\n\n";
-
-    if (!requestRecord.empty())
+    << "\t15 - Request a class switch" << "\n"
+    << "\t16 - Process a file of requests" << "\n"
+    << "\n" << center("TIMES", ' ', MENU_WIDTH) << "\n"
+    << "\t17 - Find when a group of students is free" << "\n"
+    << "\t18 - Consult the lectures and students in session at a time" << "\n"
+    << "\n" << center("STATISTICS", ' ', MENU_WIDTH) << "\n"
+    << "\t19 - Consult engine statistics" << "\n"
+    << "\n" << center("HISTORY", ' ', MENU_WIDTH) << "\n"
+    << "\t20 - Consult the course as it was after a past request" << "\n\n";
+
+    if (pastCourse != nullptr)
+        std::cout << "Press 'p' to go back to the present course.\n";
+    else if (!requestRecord.empty())
         printUndo();
     printExit();
     std::cout << "Press the number corresponding the action you want." << "\n";
@@ -95,11 +143,22 @@ void Terminal::waitMenu(){
     std::cin >> choice;             // Fetch the option chosen
     if (choice == "q")              // Quit
         return;
-    if (choice == "u" && !requestRecord.empty()) {               // Undo last request
+    if (choice == "p" && pastCourse != nullptr) {               // Back to the present course
+        pastCourse.reset();
+        printMainMenu();
+        return;
+    }
+    if (choice == "u" && !requestRecord.empty() && pastCourse == nullptr) {               // Undo last request
         printUndoMenu();
         return;
     }
-    system("clear");
+    screen.clear();
+    if (pastCourse != nullptr && (choice == "12" || choice == "13" || choice == "14" || choice == "15" || choice == "16")) {
+        std::cout << "The requests change the present course, go back to it to make a request.";
+        endDisplayMenu();
+        getInput();
+        return;
+    }
     switch (stoi(choice)) {
         // Consult the UC's of a year
         case 0: {
@@ -257,26 +316,345 @@ void Terminal::waitMenu(){
             assessRequest(request);
             break;
         }
+        // Process a file of requests
+        case 16: {
+            std::cout << "Enter the path of the file (one request per line, like the request history): ";
+            std::string path;
+            std::cin >> path;        // Fetch file path
+            processRequestFile(path);
+            break;
+        }
+        // Find when a group of students is free
+        case 17: {
+            groupAvailabilityMenu();
+            break;
+        }
+        // Consult the lectures and students in session at a time
+        case 18: {
+            std::cout << "Enter the weekday: ";
+            std::string weekday;
+            std::cin >> weekday;        // Fetch weekday
+            std::cout << "Enter the hour (ex. 10.5 for 10:30): ";
+            float hour;
+            std::cin >> hour;        // Fetch hour
+            printInSession(weekday, hour);
+            break;
+        }
+        // Consult engine statistics
+        case 19: {
+            printStatistics();
+            break;
+        }
+        // Consult the course as it was after a past request
+        case 20: {
+            std::cout << "There are " << history.size() << " requests in the history.\n"
+                      << "Enter the number of requests done (0 for none) or a date and time (ex. 2023-10-19T14:30): ";
+            std::string point;
+            std::cin >> point;        // Fetch number of requests or time
+            consultPast(point);
+            break;
+        }
         default: {
             printMainMenu();
         }
     }
 }
 
+/**
+ * @brief Asks for a group of students (a list of student codes, the students of a class or of a UC) and prints when
+ * they are free.
+ */
+void Terminal::groupAvailabilityMenu() {
+    std::cout << "Find when these students are free:\n"
+              << "\t0 - a list of students\n"
+              << "\t1 - the students of a class\n"
+              << "\t2 - the students of a UC\n";
+    std::string choice;
+    std::cin >> choice;         // Fetch the kind of group
+    std::ostringstream message;
+    std::vector<Student*> students;
+    if (choice == "0") {
+        std::cout << "Enter the student codes, separated by spaces, and a '.' at the end: ";
+        std::vector<std::string> unknown;
+        std::set<std::string> codes;
+        std::string studentCode;
+        while (std::cin >> studentCode && studentCode != ".") {        // Fetch student codes
+            Student *student = consulted().findStudentByCode(studentCode);
+            if (student == nullptr)
+                unknown.push_back(studentCode);
+            else if (codes.insert(studentCode).second)
+                students.push_back(student);
+        }
+        message << "This is when the " << students.size() << " students of the list are free\n";
+        for (const std::string &code : unknown)
+            message << "Student " << code << " doesn't exist and was left out.\n";
+    }
+    else if (choice == "1") {
+        std::cout << "Enter the UC code: ";
+        std::string ucCode;
+        std::cin >> ucCode;        // Fetch UC code
+        std::cout << "Enter the class code: ";
+        std::string classCode;
+        std::cin >> classCode;        // Fetch class code
+        students = consulted().getStudentsInClass(classCode, ucCode);
+        message << "This is when the " << students.size() << " students of class " << classCode << " in UC " << ucCode << " are free\n";
+    }
+    else if (choice == "2") {
+        std::cout << "Enter the UC code: ";
+        std::string ucCode;
+        std::cin >> ucCode;        // Fetch UC code
+        students = consulted().getStudentsInUC(ucCode);
+        message << "This is when the " << students.size() << " students of UC " << ucCode << " are free\n";
+    }
+    else {
+        printMainMenu();
+        return;
+    }
+    printGroupAvailability(students, message.str());
+}
+
+/**
+ * @brief Prints the half hours in which every student of a group is free, grouped in windows, and a table with the
+ * number of students of the group free in each half hour of the week.
+ * @param students
+ * @param message Description of the group
+ * @details Time complexity O(n * log n) n = number of students, the slots of the week are combined a word at a time
+ */
+void Terminal::printGroupAvailability(const std::vector<Student*> &students, const std::string &message) {
+    screen.clear();
+    std::cout << message << "\n";
+
+    Timeslots::Mask commonFree;
+    std::vector<int> available;
+    {
+        METRICS_TIMER(QUERY_GROUP_AVAILABILITY);
+        commonFree = consulted().getCommonFreeSlots(students);
+        available = consulted().getSlotAvailability(students);
+    }
+
+    // Windows in which everyone is free, consecutive free half hours of the same day
+    std::cout << "Everyone is free:\n";
+    for (int weekday = 0; weekday < Timeslots::DAYS; weekday++) {
+        std::cout << "\t" << std::setw(10) << std::setfill(' ') << std::left << formatWeekday(weekday) << std::right;
+        bool anyWindow = false;
+        int first = weekday * Timeslots::SLOTS_PER_DAY;
+        int end = first + Timeslots::SLOTS_PER_DAY;
+        for (int slot = first; slot < end; slot++) {
+            if (!commonFree[slot])
+                continue;
+            int windowStart = slot;
+            while (slot + 1 < end && commonFree[slot + 1])
+                slot++;
+            std::cout << (anyWindow ? ", " : "") << formatHourRange(Timeslots::getHour(windowStart), Timeslots::getHour(slot) + 0.5);
+            anyWindow = true;
+        }
+        std::cout << (anyWindow ? "" : "never") << "\n";
+    }
+
+    // Number of free students in each half hour
+    std::cout << "\nStudents free in each half hour (out of " << students.size() << "):\n";
+    for (int i = 0; i < 1 + Timeslots::DAYS; i++)
+        std::cout << "|" << fill('-', AVAILABILITY_COL_WIDTH);
+    std::cout << "|\n|" << center("HOURS", ' ', AVAILABILITY_COL_WIDTH);
+    for (int weekday = 0; weekday < Timeslots::DAYS; weekday++) {
+        std::string day = formatWeekday(weekday);
+        std::transform(day.begin(), day.end(), day.begin(), ::toupper);
+        std::cout << "|" << center(day, ' ', AVAILABILITY_COL_WIDTH);
+    }
+    std::cout << "|\n";
+    for (int i = 0; i < 1 + Timeslots::DAYS; i++)
+        std::cout << "|" << fill('-', AVAILABILITY_COL_WIDTH);
+    std::cout << "|\n";
+    for (int slotOfDay = 0; slotOfDay < Timeslots::SLOTS_PER_DAY; slotOfDay++) {
+        float hour = Timeslots::getHour(slotOfDay);
+        std::cout << "|" << center(formatHourRange(hour, hour + 0.5), ' ', AVAILABILITY_COL_WIDTH);
+        for (int weekday = 0; weekday < Timeslots::DAYS; weekday++) {
+            int slot = weekday * Timeslots::SLOTS_PER_DAY + slotOfDay;
+            std::cout << "|" << center(commonFree[slot] ? "all" : std::to_string(available[slot]), ' ', AVAILABILITY_COL_WIDTH);
+        }
+        std::cout << "|\n";
+    }
+    for (int i = 0; i < 1 + Timeslots::DAYS; i++)
+        std::cout << "|" << fill('-', AVAILABILITY_COL_WIDTH);
+    std::cout << "|\n";
+
+    endDisplayMenu();
+    getInput();
+}
+
+/**
+ * @brief Prints the lectures in session at a time of the week, with the number of students attending each one, and the
+ * number of different students in session. The students can then be listed.
+ * @param weekday
+ * @param hour
+ * @details Time complexity O(l), l = number of lectures in session, O(s log s) to list the s students
+ */
+void Terminal::printInSession(const std::string &weekday, float hour) {
+    screen.clear();
+    int day = Timeslots::parseWeekday(weekday);
+    if (day == -1 || hour < Timeslots::FIRST_HOUR || hour >= Timeslots::LAST_HOUR) {
+        std::cout << "There are no lectures on " << weekday << " at " << formatHour(hour) << ".";
+        endDisplayMenu();
+        getInput();
+        return;
+    }
+    std::vector<std::pair<const Lecture*, const Class*>> lectures;
+    int studentsInSession;
+    {
+        METRICS_TIMER(QUERY_IN_SESSION);
+        lectures = consulted().getLecturesAt(day, hour);
+        studentsInSession = consulted().getStudentsInSessionAt(day, hour);
+    }
+    std::ostringstream when;
+    when << formatWeekday(day) << " at " << formatHour(hour);
+    std::cout << "These are the lectures in session on " << when.str() << "\n\n";
+
+    std::cout << "|" << center("UC", ' ', OVERLAPPED_COL_WIDTH)
+              << "|" << center("CLASS", ' ', OVERLAPPED_COL_WIDTH)
+              << "|" << center("HOUR", ' ', OVERLAPPED_COL_WIDTH)
+              << "|" << center("STUDENTS", ' ', OVERLAPPED_COL_WIDTH) << "|\n";
+    for (int i = 0; i < 4; i++)
+        std::cout << "|" << fill('-', OVERLAPPED_COL_WIDTH);
+    std::cout << "|\n";
+    for (const auto &[lecture, class_] : lectures) {
+        std::cout << "|" << center(formatUcAndType(lecture->getUC(), lecture->getType()), ' ', OVERLAPPED_COL_WIDTH);
+        std::cout << "|" << center(lecture->getClass(), ' ', OVERLAPPED_COL_WIDTH);
+        std::cout << "|" << center(formatHourRange(lecture->getStartHour(), lecture->getEndHour()), ' ', OVERLAPPED_COL_WIDTH);
+        std::cout << "|" << center(std::to_string(class_->getOccupation()), ' ', OVERLAPPED_COL_WIDTH) << "|\n";
+    }
+    std::cout << "\n" << lectures.size() << " lectures, " << studentsInSession << " students in session.";
+
+    std::cout << "\n\nPress 'l' to list the students in session.\n";
+    printBackToMenu();
+    printExit();
+    if (getInput() == 'l') {
+        // A student attending overlapping lectures is listed once
+        std::set<Student*, cmp> unique;
+        for (const auto &[lecture, class_] : lectures)
+            unique.insert(class_->getStudents().begin(), class_->getStudents().end());
+        std::vector<Student*> students(unique.begin(), unique.end());
+        sortingOptions sortOptions;
+        printStudents(students, "These are the students in session on " + when.str() + "\n\n", sortOptions);
+    }
+}
+
+/**
+ * @brief Prints the latency histograms and rejection counters collected so far.
+ */
+void Terminal::printStatistics() {
+    screen.clear();
+    std::cout << "These are the engine statistics since the program started\n\n";
+    Metrics::print(std::cout);
+    endDisplayMenu();
+    getInput();
+}
+
+/**
+ * @brief Rebuilds the Course as it was at a point of the history, see History::getCourseAfter. The consults read it
+ * until the user goes back to the present course.
+ * @param point number of requests done or a time, see History::parsePoint
+ */
+void Terminal::consultPast(const std::string &point) {
+    size_t count;
+    if (!history.parsePoint(point, count)) {
+        screen.clear();
+        std::cout << "There is no point " << point << " in the history of " << history.size() << " requests.";
+        endDisplayMenu();
+        getInput();
+        return;
+    }
+    pastCourse = history.getCourseAfter(count);
+    pastCourseRequests = count;
+    printMainMenu();
+}
+
+/**
+ * @brief Prints which past Course is being consulted
+ */
+void Terminal::printPastCourse() {
+    std::cout << "Consulting the course after " << pastCourseRequests << " of the " << history.size() << " requests";
+    std::string last = history.getRequest(pastCourseRequests);
+    if (!last.empty())
+        std::cout << ", the last one was " << last;
+    std::cout << ".\n\n";
+}
+
 /**
  * @brief Sends the request to course so that it can be assessed.
  * @param request Request to be assessed
  */
 void Terminal::assessRequest(Request *request) {
-    system("clear");
+    screen.clear();
     if (course.assessRequest(request)) {
-        if (!request->isUndo())
+        if (!request->isUndo()) {
             requestRecord.push(request);
+            history.record(request);
+        }
         std::cout << "Your request was accepted.\n" << request->toStr();
+        promoteWaitlist();
     } else {
         std::cout << request->getMessage();
-        delete request;
+        size_t position = 0;
+        if (!request->isUndo() && Waitlist::canWait(request))
+            position = waitlist.add(request);
+        if (position > 0)
+            std::cout << "The request is number " << position << " in the waitlist, it will be done as soon as a seat is freed.\n";
+        else
+            delete request;
+    }
+    endDisplayMenu();
+    getInput();
+}
+
+/**
+ * @brief Gives the seats freed by the last requests to the requests in the waitlist, and prints the ones done.
+ */
+void Terminal::promoteWaitlist() {
+    for (Request *request : waitlist.promote(course)) {
+        requestRecord.push(request);
+        history.record(request);
+        std::cout << "\nDone from the waitlist: " << request->toStr();
     }
+}
+
+/**
+ * @brief Assesses every request of a file together, see Course::assessRequestBatch.
+ * @param path file with one request per line, in the format of the request history
+ */
+void Terminal::processRequestFile(const std::string &path) {
+    screen.clear();
+    std::queue<Request*> requests;
+    Auxiliar::loadRequestRecord(requests, path);
+    size_t total = requests.size();
+    std::vector<Request*> batch;
+    for (; !requests.empty(); requests.pop())
+        batch.push_back(requests.front());
+    course.assessRequestBatch(batch);
+
+    // Accepted requests can be undone like the others, the rejected ones are only counted or wait for a seat
+    int accepted = 0, waiting = 0;
+    int rejections[Request::REJECTION_COUNT] = {};
+    for (Request *request : batch) {
+        if (request->getRejection() == Request::ACCEPTED) {
+            requestRecord.push(request);
+            history.record(request);
+            accepted++;
+        } else {
+            rejections[request->getRejection()]++;
+            if (Waitlist::canWait(request) && waitlist.add(request) > 0)
+                waiting++;
+            else
+                delete request;
+        }
+    }
+    std::cout << "Read " << total << " requests from " << path << ", " << accepted << " were accepted.\n";
+    for (int rejection = Request::ACCEPTED + 1; rejection < Request::REJECTION_COUNT; rejection++) {
+        if (rejections[rejection] > 0)
+            std::cout << "\t" << rejections[rejection] << " rejected: " << Request::getRejectionName((Request::Rejection) rejection) << "\n";
+    }
+    if (waiting > 0)
+        std::cout << waiting << " of the rejected requests are in the waitlist.\n";
+    promoteWaitlist();
     endDisplayMenu();
     getInput();
 }
@@ -287,26 +665,8 @@ void Terminal::assessRequest(Request *request) {
 void Terminal::undoLastRequest() {
     Request *request = requestRecord.top();
     requestRecord.pop();
-    if (JoinRequest* joinReq = dynamic_cast<JoinRequest*>(request)) {
-        Request *undoRequest = new LeaveRequest(joinReq->getStudentCode(), joinReq->getUcCode());
-        undoRequest->setUndo();
-        assessRequest(undoRequest);
-    }
-    else if (LeaveRequest* leaveReq = dynamic_cast<LeaveRequest*>(request)) {
-        Request *undoRequest = new JoinRequest(leaveReq->getStudentCode(), leaveReq->getUcCode());
-        undoRequest->setUndo();
-        assessRequest(undoRequest);
-    }
-    else if (SwitchUcRequest* switchUcReq = dynamic_cast<SwitchUcRequest*>(request)) {
-        Request *undoRequest = new SwitchUcRequest(switchUcReq->getStudentCode(), switchUcReq->getUcCodeNext(), switchUcReq->getUcCodeCurrent());
-        undoRequest->setUndo();
-        assessRequest(undoRequest);
-    }
-    else if (SwitchClassRequest* switchClassReq = dynamic_cast<SwitchClassRequest*>(request)) {
-        Request *undoRequest = new SwitchClassRequest(switchClassReq->getStudentCode(), switchClassReq->getUcCode(), switchClassReq->getClassCodeNext(), switchClassReq->getClassCodeCurrent());
-        undoRequest->setUndo();
-        assessRequest(undoRequest);
-    }
+    history.undo();
+    assessRequest(request->getUndoRequest());
     delete request;
 }
 
@@ -315,7 +675,7 @@ void Terminal::printUndo() {
 }
 
 void Terminal::printUndoMenu() {
-    system("clear");
+    screen.clear();
     std::cout << "The most recent request is: " << requestRecord.top()->toStr() << ".\n\n";
     std::cout << "Are you sure you want to undo this request? (y/n)";
     char input;
@@ -333,10 +693,14 @@ void Terminal::printUndoMenu() {
  * @param year
  */
 void Terminal::printUCsInYear(std::string year) {
-    system("clear");
+    screen.clear();
     std::cout << "These are the UC's in year " << year << "\n\n";
 
-    std::vector<UC> UCs = course.getUCsInYear(year);
+    std::vector<UC> UCs;
+    {
+        METRICS_TIMER(QUERY_UCS_IN_YEAR);
+        UCs = consulted().getUCsInYear(year);
+    }
     int UCsPerLine = 0;
     int maxUCsPerLine = 6;
     for (auto UC = UCs.begin(); UC != UCs.end(); UC++) {
@@ -356,10 +720,14 @@ void Terminal::printUCsInYear(std::string year) {
  * @param ucCode
  */
 void Terminal::printClassesInUC(std::string ucCode) {
-    system("clear");
+    screen.clear();
     std::cout << "These are the classes of UC " << ucCode << "\n\n";
 
-    std::vector<Class> classes = course.getClassesInUC(ucCode);
+    std::vector<Class> classes;
+    {
+        METRICS_TIMER(QUERY_CLASSES_IN_UC);
+        classes = consulted().getClassesInUC(ucCode);
+    }
     int classesPerLine = 0;
     int maxClassesPerLine = 6;
     for (auto class_ = classes.begin(); class_ != classes.end(); class_++) {
@@ -379,17 +747,18 @@ void Terminal::printClassesInUC(std::string ucCode) {
  * @param studentCode
  */
 void Terminal::printStudentClasses(std::string studentCode) {
-    system("clear");
+    screen.clear();
     std::cout << "These are the classes of student " << studentCode << "\n\n";
 
     std::cout << center("UC", ' ', OVERLAPPED_COL_WIDTH) << "|" << center("Class", ' ', OVERLAPPED_COL_WIDTH) << "\n";        // Column titles
     std::cout << fill('-', OVERLAPPED_COL_WIDTH) << "|" << fill('-', OVERLAPPED_COL_WIDTH) << "\n";           // Separators
 
-    std::set<Class> classes = course.getStudentClasses(studentCode);
-    std::vector<Class> sortedClasses;
-    for (Class class_ : classes) {
-        sortedClasses.push_back(class_);
+    std::set<Class> classes;
+    {
+        METRICS_TIMER(QUERY_STUDENT_CLASSES);
+        classes = consulted().getStudentClasses(studentCode);
     }
+    std::vector<Class> sortedClasses(classes.begin(), classes.end());
     std::sort(sortedClasses.begin(), sortedClasses.end(), classesByUcCode);
     for (const Class &class_ : sortedClasses) {
         std::cout << center(class_.getUC(), ' ', OVERLAPPED_COL_WIDTH) << "|" << center(class_.getClassCode(), ' ', OVERLAPPED_COL_WIDTH) << "\n";
@@ -403,11 +772,15 @@ void Terminal::printStudentClasses(std::string studentCode) {
  * @param ucCode
  */
 void Terminal::printUcSchedule(std::string& ucCode) {
-    system("clear");
+    screen.clear();
     std::cout << "This is the schedule of UC " << ucCode << "\n\n";
 
-    Schedule schedule = course.getUcSchedule(ucCode);
-    printSchedule(schedule);
+    const ScheduleLayout *layout;
+    {
+        METRICS_TIMER(QUERY_UC_SCHEDULE);
+        layout = &getScheduleLayout("UC " + ucCode, [&]() { return consulted().getUcSchedule(ucCode); });
+    }
+    printSchedule(*layout);
 }
 
 /**
@@ -415,11 +788,15 @@ void Terminal::printUcSchedule(std::string& ucCode) {
  * @param classCode
  */
 void Terminal::printClassSchedule(std::string& classCode) {
-    system("clear");
+    screen.clear();
     std::cout << "This is the schedule of class " << classCode << "\n\n";
 
-    Schedule schedule = course.getClassSchedule(classCode);
-    printSchedule(schedule);
+    const ScheduleLayout *layout;
+    {
+        METRICS_TIMER(QUERY_CLASS_SCHEDULE);
+        layout = &getScheduleLayout("class " + classCode, [&]() { return consulted().getClassSchedule(classCode); });
+    }
+    printSchedule(*layout);
 }
 
 /**
@@ -427,188 +804,161 @@ void Terminal::printClassSchedule(std::string& classCode) {
  * @param studentCode
  */
 void Terminal::printStudentSchedule(std::string& studentCode) {
-    system("clear");
+    screen.clear();
     std::cout << "This is the schedule of student " << studentCode << "\n\n";
 
-    Schedule schedule = course.getStudentSchedule(studentCode);
-    printSchedule(schedule);
+    ScheduleLayout layout;
+    {
+        METRICS_TIMER(QUERY_STUDENT_SCHEDULE);
+        layout = ScheduleLayout(consulted().getStudentSchedule(studentCode));
+    }
+    printSchedule(layout);
 }
 
 /**
  * @brief Main method to print a schedule. Prints a schedule table and overlapped lectures table, if there are any.
- * @details Time complexity O(nlog(n)), n = number of lectures in the schedule
- * @param schedule
+ * @param layout
  */
-void Terminal::printSchedule(const Schedule& schedule) {
-
-    // lines printed within a lecture
-    std::vector weekdays = {-1,-1,-1,-1,-1,-1};
-
-    // stores the lectures who were overlapped and couldn't be displayed
-    std::set<Lecture> overlapped;
+void Terminal::printSchedule(const ScheduleLayout &layout) {
+    writeSchedule(std::cout, layout);
+    endDisplayMenu();
+    getInput();
+}
 
-    // stores the lectures
-    std::set<Lecture> lectures = schedule.getLectures();
+/**
+ * @brief Writes a schedule table and overlapped lectures table, if there are any, e.g. to print it or to export it.
+ * The lectures were already placed by the layout, so each cell is only formatted.
+ * @details Time complexity O(s + o log o), s = number of cells of the table, o = number of overlapped lectures
+ * @param os
+ * @param layout
+ */
+void Terminal::writeSchedule(std::ostream &os, const ScheduleLayout &layout) {
 
     // HEADERS
     for (int i = 0; i < 3; i++) {
         if (i == 0 || i == 2) {
             for (int j = 0; j < 7; j++) {
-                std::cout << "|" << fill('-', SCHEDULE_COL_WIDTH);
+                os << "|" << fill('-', SCHEDULE_COL_WIDTH);
             }
         }
         else {
-            std::cout << "|" << center("HOURS", ' ', SCHEDULE_COL_WIDTH);
-            std::cout << "|" << center("MONDAY", ' ', SCHEDULE_COL_WIDTH);
-            std::cout << "|" << center("TUESDAY", ' ', SCHEDULE_COL_WIDTH);
-            std::cout << "|" << center("WEDNESDAY", ' ', SCHEDULE_COL_WIDTH);
-            std::cout << "|" << center("THURSDAY", ' ', SCHEDULE_COL_WIDTH);
-            std::cout << "|" << center("FRIDAY", ' ', SCHEDULE_COL_WIDTH);
-            std::cout << "|" << center("SATURDAY", ' ', SCHEDULE_COL_WIDTH);
+            os << "|" << center("HOURS", ' ', SCHEDULE_COL_WIDTH);
+            os << "|" << center("MONDAY", ' ', SCHEDULE_COL_WIDTH);
+            os << "|" << center("TUESDAY", ' ', SCHEDULE_COL_WIDTH);
+            os << "|" << center("WEDNESDAY", ' ', SCHEDULE_COL_WIDTH);
+            os << "|" << center("THURSDAY", ' ', SCHEDULE_COL_WIDTH);
+            os << "|" << center("FRIDAY", ' ', SCHEDULE_COL_WIDTH);
+            os << "|" << center("SATURDAY", ' ', SCHEDULE_COL_WIDTH);
         }
-        std::cout << "|\n";
+        os << "|\n";
     }
 
-    float hour = 8;         // Start hour of the first possible lecture
     // SCHEDULE
-    while (hour < 22) {
+    for (int slotOfDay = 0; slotOfDay < Timeslots::SLOTS_PER_DAY; slotOfDay++) {
+        float hour = Timeslots::getHour(slotOfDay);
         // Print a block of lines (ex. 08:00 - 08:30)
         for (int line = 0; line < 2; line++) {
-            // Print a line
-
             // Hours
             if (line == 0) {
-                std::cout << "|" << center(formatHourRange(hour, hour + 0.5), ' ', SCHEDULE_COL_WIDTH);
+                os << "|" << center(formatHourRange(hour, hour + 0.5), ' ', SCHEDULE_COL_WIDTH);
             } else {
-                std::cout << "|" << fill('-', SCHEDULE_COL_WIDTH);
+                os << "|" << fill('-', SCHEDULE_COL_WIDTH);
             }
 
             // Weekdays
-            for (int weekday = 0; weekday < 6; weekday++) {
-                bool printedLine = false;           // Already printed a line for this weekday
-                bool foundOverlapped = false;
-                do {
-                    for (auto lecture = lectures.begin(); lecture != lectures.end(); lecture++) {
-                        if (lecture->getWeekday() == weekday && lecture->isOccurring(hour)) {
-                            // Overlapped
-                            if ((weekdays[weekday] == -1 && hour != lecture->getStartHour()) ||
-                                (weekdays[weekday] > 1 && hour == lecture->getStartHour())) {
-                                overlapped.insert(*lecture);
-                                lectures.erase(lecture);
-                                foundOverlapped = true;
-                                break;
-                            }
-
-
-                            // Done printing this lecture
-                            if (lecture->getEndHour() == (hour + 0.5) && line == 1) {
-                                std::cout << "|" << fill('-', SCHEDULE_COL_WIDTH);
-                                weekdays[weekday] = -1;
-                                printedLine = true;
-                                foundOverlapped = false;
-                                lectures.erase(lecture);
-                                break;
-                            }
-
-                            // Currently printing the 0 line (first blank of the lecture)
-                            if (weekdays[weekday] == -1 && hour == lecture->getStartHour()) {
-                                weekdays[weekday] = 0;
-                            }
-
-                            // Print UC (type)
-                            if (weekdays[weekday] == getMiddleOfLectureBox(lecture->getDuration()) - 1) {
-                                std::cout << "|" << center(formatUcAndType(lecture->getUC(), lecture->getType()), ' ',
-                                                           SCHEDULE_COL_WIDTH);
-                            }
-                            // Print Class
-                            else if (weekdays[weekday] == getMiddleOfLectureBox(lecture->getDuration()) + 1) {
-                                std::cout << "|" << center(lecture->getClass(), ' ', SCHEDULE_COL_WIDTH);
-                            }
-                            // Otherwise print blank
-                            else {
-                                std::cout << "|" << fill(' ', SCHEDULE_COL_WIDTH);
-                            }
-
-                            weekdays[weekday]++;        // Increment lines printed
-
-                            printedLine = true;
-                            foundOverlapped = false;
-                            break;
-                        }
-                        foundOverlapped = false;
-                    }
-                } while (foundOverlapped);
+            for (int weekday = 0; weekday < Timeslots::DAYS; weekday++) {
+                const ScheduleLayout::Placement *placement = layout.getPlacement(weekday, slotOfDay);
                 // No lectures occurring
-                if (!printedLine) {
-                    if (line == 0)
-                        std::cout << "|" << fill(' ', SCHEDULE_COL_WIDTH);
-                    else
-                        std::cout << "|" << fill('-', SCHEDULE_COL_WIDTH);
+                if (placement == nullptr) {
+                    os << "|" << fill(line == 0 ? ' ' : '-', SCHEDULE_COL_WIDTH);
+                    continue;
                 }
+                const Lecture &lecture = placement->lecture;
+                int lineOfLecture = (slotOfDay - placement->firstSlot) * 2 + line;
+                int middle = getMiddleOfLectureBox(lecture.getDuration());
+                // Done printing this lecture
+                if (slotOfDay == placement->firstSlot + placement->slots - 1 && line == 1)
+                    os << "|" << fill('-', SCHEDULE_COL_WIDTH);
+                // Print UC (type)
+                else if (lineOfLecture == middle - 1)
+                    os << "|" << center(formatUcAndType(lecture.getUC(), lecture.getType()), ' ', SCHEDULE_COL_WIDTH);
+                // Print Class
+                else if (lineOfLecture == middle + 1)
+                    os << "|" << center(lecture.getClass(), ' ', SCHEDULE_COL_WIDTH);
+                // Otherwise print blank
+                else
+                    os << "|" << fill(' ', SCHEDULE_COL_WIDTH);
             }
-            std::cout << "|\n";
+            os << "|\n";
         }
-        hour += 0.5;
-    }
-    for (Lecture lecture : lectures) {
-        overlapped.insert(lecture);
     }
 
+    std::set<Lecture> overlapped = layout.getOverlapped();
     if (!overlapped.empty())
-        printOverlappedLectures(overlapped);
+        writeOverlappedLectures(os, overlapped);
+}
 
-    endDisplayMenu();
-    getInput();
+/**
+ * @brief Gets the layout of a class or UC schedule, built again only if a timetable changed since it was cached.
+ * @param key Identifies the schedule, e.g. "UC L.EIC001"
+ * @param getSchedule Gets the schedule when the layout has to be built
+ * @return layout of the schedule
+ */
+const ScheduleLayout& Terminal::getScheduleLayout(const std::string &key, const std::function<Schedule()> &getSchedule) {
+    auto cached = layoutCache.find(key);
+    if (cached == layoutCache.end())
+        cached = layoutCache.emplace(key, std::make_pair(consulted().getTimetableVersion(), ScheduleLayout(getSchedule()))).first;
+    else if (cached->second.first != consulted().getTimetableVersion())
+        cached->second = {consulted().getTimetableVersion(), ScheduleLayout(getSchedule())};
+    return cached->second.second;
 }
 
 /**
- * @brief Prints the overlapped lectures that couldn't be printed in the schedule table.
+ * @brief Writes the overlapped lectures that couldn't be printed in the schedule table.
  * @details Time complexity O(nlog(n)), n = number of overlapped lectures
+ * @param os
  * @param lectures
  */
-void Terminal::printOverlappedLectures(const std::set<Lecture> &lectures) {
+void Terminal::writeOverlappedLectures(std::ostream &os, const std::set<Lecture> &lectures) {
     // Table title
-    std::cout << "\n|" << fill('-', 4 * OVERLAPPED_COL_WIDTH + 3) << "|\n";
-    std::cout << "|" << center("OVERLAPPED LECTURES", ' ', 4 * OVERLAPPED_COL_WIDTH + 3) << "|\n";
+    os << "\n|" << fill('-', 4 * OVERLAPPED_COL_WIDTH + 3) << "|\n";
+    os << "|" << center("OVERLAPPED LECTURES", ' ', 4 * OVERLAPPED_COL_WIDTH + 3) << "|\n";
 
     // Separate tile from headers
-    std::cout << "|" << fill('-', OVERLAPPED_COL_WIDTH);
+    os << "|" << fill('-', OVERLAPPED_COL_WIDTH);
     for (int i = 0; i < 3; i++) {
-        std::cout << "-" << fill('-', OVERLAPPED_COL_WIDTH);
+        os << "-" << fill('-', OVERLAPPED_COL_WIDTH);
     }
-    std::cout << "|\n";
+    os << "|\n";
 
     // Table headers
-    std::cout << "|" << center("UC", ' ', OVERLAPPED_COL_WIDTH)
+    os << "|" << center("UC", ' ', OVERLAPPED_COL_WIDTH)
             << "|" << center("WEEKDAY", ' ', OVERLAPPED_COL_WIDTH)
             << "|" << center("HOUR", ' ', OVERLAPPED_COL_WIDTH)
             << "|" << center("CLASS", ' ', OVERLAPPED_COL_WIDTH) << "|\n";
     // Separate headers from lectures
     for (int i = 0; i < 4; i++) {
-        std::cout << "|" << fill('-', OVERLAPPED_COL_WIDTH);
+        os << "|" << fill('-', OVERLAPPED_COL_WIDTH);
     }
-    std::cout << "|\n";
+    os << "|\n";
 
     // Sort lectures by weekday
-    std::vector<Lecture> orderedLectures;
-    for (Lecture lecture : lectures) {
-        orderedLectures.push_back(lecture);
-    }
+    std::vector<Lecture> orderedLectures(lectures.begin(), lectures.end());
     sort(orderedLectures.begin(), orderedLectures.end(), byWeekday);
 
     // Print lectures
     for (auto lecture = orderedLectures.begin(); lecture != orderedLectures.end(); lecture++) {
-        std::cout << "|" << center(formatUcAndType(lecture->getUC(), lecture->getType()), ' ', OVERLAPPED_COL_WIDTH);
-        std::cout << "|" << center(formatWeekday(lecture->getWeekday()), ' ', OVERLAPPED_COL_WIDTH);
-        std::cout << "|" << center(formatHourRange(lecture->getStartHour(), lecture->getEndHour()), ' ', OVERLAPPED_COL_WIDTH);
-        std::cout << "|" << center(lecture->getClass(), ' ', OVERLAPPED_COL_WIDTH) << "|\n";
+        os << "|" << center(formatUcAndType(lecture->getUC(), lecture->getType()), ' ', OVERLAPPED_COL_WIDTH);
+        os << "|" << center(formatWeekday(lecture->getWeekday()), ' ', OVERLAPPED_COL_WIDTH);
+        os << "|" << center(formatHourRange(lecture->getStartHour(), lecture->getEndHour()), ' ', OVERLAPPED_COL_WIDTH);
+        os << "|" << center(lecture->getClass(), ' ', OVERLAPPED_COL_WIDTH) << "|\n";
     }
     // Close table
-    std::cout << "|" << fill('-', OVERLAPPED_COL_WIDTH);
+    os << "|" << fill('-', OVERLAPPED_COL_WIDTH);
     for (int i = 0; i < 3; i++) {
-        std::cout << "-" << fill('-', OVERLAPPED_COL_WIDTH);
+        os << "-" << fill('-', OVERLAPPED_COL_WIDTH);
     }
-    std::cout << "|\n";
+    os << "|\n";
 }
 
 /**
@@ -618,9 +968,7 @@ void Terminal::printOverlappedLectures(const std::set<Lecture> &lectures) {
  * @return String with length width filled with c
  */
 std::string Terminal::fill(char c, int width) {
-    std::ostringstream oss;
-    oss << std::setw(width) << std::setfill(c) << "";
-    return oss.str();
+    return std::string(std::max(width, 0), c);
 }
 
 /**
@@ -684,10 +1032,12 @@ std::string Terminal::formatWeekday(int weekday) {
  * @return String of length width with str centered and surrounded by sep
  */
 std::string Terminal::center(const std::string &str, char sep, int width) {
-    std::ostringstream oss;
-    int space = (width - str.length()) / 2;
-    std::cout << std::setw(space) << std::setfill(sep) << "" << str << std::setw(width - str.length() - space) << std::setfill(sep) << "";
-    return oss.str();
+    if ((int) str.length() >= width)
+        return str;
+    int space = (width - (int) str.length()) / 2;
+    std::string centered(width, sep);
+    centered.replace(space, str.length(), str);
+    return centered;
 }
 
 /**
@@ -713,7 +1063,11 @@ void Terminal::printStudentsInClass(std::string classCode, std::string ucCode) {
     std::ostringstream message;
     message << "These are the students registered in class " << classCode << " in UC " << ucCode << "\n\n";
 
-    std::vector<Student*> students = course.getStudentsInClass(classCode, ucCode);
+    std::vector<Student*> students;
+    {
+        METRICS_TIMER(QUERY_STUDENTS_IN_CLASS);
+        students = consulted().getStudentsInClass(classCode, ucCode);
+    }
     sortingOptions sortOptions;
     printStudents(students, message.str(), sortOptions);
 }
@@ -726,7 +1080,11 @@ void Terminal::printStudentsInUC(std::string ucCode) {
     std::ostringstream message;
     message << "These are the students registered in UC " << ucCode << "\n\n";
 
-    std::vector<Student*> students = course.getStudentsInUC(ucCode);
+    std::vector<Student*> students;
+    {
+        METRICS_TIMER(QUERY_STUDENTS_IN_UC);
+        students = consulted().getStudentsInUC(ucCode);
+    }
     sortingOptions sortOptions;
     printStudents(students, message.str(), sortOptions);
 }
@@ -739,7 +1097,11 @@ void Terminal::printStudentsInYear(std::string year) {
     std::ostringstream message;
     message << "These are the students registered in year " << year << "\n\n";
 
-    std::vector<Student*> students = course.getStudentsInYear(year);
+    std::vector<Student*> students;
+    {
+        METRICS_TIMER(QUERY_STUDENTS_IN_YEAR);
+        students = consulted().getStudentsInYear(year);
+    }
     sortingOptions sortOptions;
     printStudents(students, message.str(), sortOptions);
 }
@@ -749,9 +1111,13 @@ void Terminal::printStudentsInYear(std::string year) {
  */
 void Terminal::printStudentsInCourse() {
     std::ostringstream message;
-    message << "These are the students registered in this course (" << course.getName() << ")" << "\n\n";
+    message << "These are the students registered in this course (" << consulted().getName() << ")" << "\n\n";
 
-    std::vector<Student*> students = course.getStudentsInCourse();
+    std::vector<Student*> students;
+    {
+        METRICS_TIMER(QUERY_STUDENTS_IN_COURSE);
+        students = consulted().getStudentsInCourse();
+    }
     sortingOptions sortOptions;
     printStudents(students, message.str(), sortOptions);
 }
@@ -764,7 +1130,11 @@ void Terminal::printStudentsInAtLeastUCs(int n) {
     std::ostringstream message;
     message << "These are the students registered in registered in at least " << n << " UC's" << "\n\n";
 
-    std::vector<Student*> students = course.getStudentsInAtLeastUCs(n);
+    std::vector<Student*> students;
+    {
+        METRICS_TIMER(QUERY_STUDENTS_IN_AT_LEAST_UCS);
+        students = consulted().getStudentsInAtLeastUCs(n);
+    }
     sortingOptions sortOptions;
     printStudents(students, message.str(), sortOptions);
 }
@@ -778,7 +1148,7 @@ void Terminal::printStudentsInAtLeastUCs(int n) {
  */
 void Terminal::printStudents(std::vector<Student*> &students, std::string message, sortingOptions &sortOptions) {
     // By default -> orders by student name and ascending
-    system("clear");
+    screen.clear();
     std::cout << message;
 
     std::cout << center("Code", ' ', STUDENT_CODE_COL_WIDTH) << "| Name" << "\n";        // Column titles
@@ -911,7 +1281,7 @@ bool Terminal::byStudentCode(Student* student1, Student* student2) {
     return student1->getStudentCode() <= student2->getStudentCode();
 }
 
-bool Terminal::byWeekday(Lecture lecture1, Lecture lecture2) {
+bool Terminal::byWeekday(const Lecture &lecture1, const Lecture &lecture2) {
     if(lecture1.getWeekday() < lecture2.getWeekday())
         return true;
     else if(lecture1.getWeekday() == lecture2.getWeekday()) {
@@ -937,14 +1307,15 @@ bool Terminal::byWeekday(Lecture lecture1, Lecture lecture2) {
 
 /**
  * @brief Main method to print the course occupation, Prints table with headers 'Year', 'UC Code', 'Class', 'Occupation', that can be sorted and filtered in different ways.
+ * Without the 'Class' column, a 'Balance' column shows the occupation of the least and most occupied classes of each UC.
  * @details Time Complexity O(nlog(n)), n = number of classes or number of UC's or number of years
  * @param sortOptions Sorting options
  * @param filterOptions Filtering options
  */
 void Terminal::printCourseOccupation(sortingOptions &sortOptions, occupationOptions &filterOptions) {
-    system("clear");
+    screen.clear();
     // By default, shows everything
-    std::cout << "This course (" << course.getName() << ") has " << course.getOccupation() << " students registered.\n\n";
+    std::cout << "This course (" << consulted().getName() << ") has " << consulted().getOccupation() << " students registered.\n\n";
 
     // Nothing to display, only number of students in course
     if (filterOptions.displayNothing())
@@ -954,6 +1325,7 @@ void Terminal::printCourseOccupation(sortingOptions &sortOptions, occupationOpti
     std::cout << "|" << fill('-', filterOptions.years * (OVERLAPPED_COL_WIDTH + 1) +
                                   filterOptions.UCs * (OVERLAPPED_COL_WIDTH + 1) +
                                   filterOptions.classes * (OVERLAPPED_COL_WIDTH + 1) +
+                                  filterOptions.displayBalance() * (OVERLAPPED_COL_WIDTH + 1) +
                                   OVERLAPPED_COL_WIDTH) << "|\n";
     printOccupationHeaders(filterOptions);
 
@@ -974,6 +1346,7 @@ void Terminal::printCourseOccupation(sortingOptions &sortOptions, occupationOpti
     std::cout << "|" << fill('-', filterOptions.years * (OVERLAPPED_COL_WIDTH + 1) +
                                   filterOptions.UCs * (OVERLAPPED_COL_WIDTH + 1) +
                                   filterOptions.classes * (OVERLAPPED_COL_WIDTH + 1) +
+                                  filterOptions.displayBalance() * (OVERLAPPED_COL_WIDTH + 1) +
                                   OVERLAPPED_COL_WIDTH) << "|\n";
 
 
@@ -995,7 +1368,11 @@ void Terminal::printCourseOccupation(sortingOptions &sortOptions, occupationOpti
  * @param filterOptions Filtering options
  */
 void Terminal::printClassOccupation(sortingOptions &sortOptions, occupationOptions &filterOptions) {
-    std::vector<Class> classes = course.getClasses();
+    std::vector<Class> classes;
+    {
+        METRICS_TIMER(QUERY_CLASS_OCCUPATION);
+        classes = consulted().getClasses();
+    }
     // Sort
     filterOptions.getRealOrderBy(sortOptions.orderBy);
     switch (sortOptions.orderBy) {
@@ -1062,7 +1439,11 @@ void Terminal::printClassOccupationLine(const Class &class_, const occupationOpt
  * @param filterOptions Filtering options
  */
 void Terminal::printUcOccupation(sortingOptions &sortOptions, occupationOptions &filterOptions) {
-    std::vector<UC> UCs = course.getUCs();
+    std::vector<UC> UCs;
+    {
+        METRICS_TIMER(QUERY_UC_OCCUPATION);
+        UCs = consulted().getUCs();
+    }
     // Sort
     filterOptions.getRealOrderBy(sortOptions.orderBy);
     switch (sortOptions.orderBy) {
@@ -1111,7 +1492,10 @@ void Terminal::printUcOccupationLine(const UC &uc, const occupationOptions &filt
             std::cout << center(uc.getYear(), ' ', OVERLAPPED_COL_WIDTH) << "|";
         }
         std::cout << center(uc.getUcCode(), ' ', OVERLAPPED_COL_WIDTH) << "|";
-        std::cout << center(std::to_string(uc.getOccupation()), ' ', OVERLAPPED_COL_WIDTH) << "|\n";
+        std::cout << center(std::to_string(uc.getOccupation()), ' ', OVERLAPPED_COL_WIDTH) << "|";
+        // Least and most occupied classes, and the difference between them
+        std::cout << center(std::to_string(uc.getMinOccupation()) + "-" + std::to_string(uc.getMaxOccupation()) +
+                            " (" + std::to_string(uc.getOccupationSpread()) + ")", ' ', OVERLAPPED_COL_WIDTH) << "|\n";
     }
 }
 
@@ -1122,7 +1506,11 @@ void Terminal::printUcOccupationLine(const UC &uc, const occupationOptions &filt
  * @param filterOptions Filtering options
  */
 void Terminal::printYearOccupation(sortingOptions &sortOptions, occupationOptions &filterOptions) {
-    std::vector<std::pair<std::string, int>> yearOccupation = course.getYearOccupation();
+    std::vector<std::pair<std::string, int>> yearOccupation;
+    {
+        METRICS_TIMER(QUERY_YEAR_OCCUPATION);
+        yearOccupation = consulted().getYearOccupation();
+    }
     // Sort
     filterOptions.getRealOrderBy(sortOptions.orderBy);
     switch (sortOptions.orderBy) {
@@ -1184,6 +1572,9 @@ void Terminal::printOccupationHeaders(const occupationOptions &filterOptions) {
             printOccupationHeader(i, "Class", OVERLAPPED_COL_WIDTH);
         }
         printOccupationHeader(i, "Occupation", OVERLAPPED_COL_WIDTH);
+        if (filterOptions.displayBalance()) {
+            printOccupationHeader(i, "Balance", OVERLAPPED_COL_WIDTH);
+        }
         std::cout << "\n";
     }
 }
@@ -1207,7 +1598,7 @@ void Terminal::OccupationMenu() {
     printExit();
 }
 
-bool Terminal::classesByYear(Class class1, Class class2) {
+bool Terminal::classesByYear(const Class &class1, const Class &class2) {
     if (class1.getYear() < class2.getYear())
         return true;
     else if (class1.getYear() < class2.getYear())
@@ -1215,7 +1606,7 @@ bool Terminal::classesByYear(Class class1, Class class2) {
     return false;
 }
 
-bool Terminal::classesByUcCode(Class class1, Class class2) {
+bool Terminal::classesByUcCode(const Class &class1, const Class &class2) {
     if (class1.getUC() < class2.getUC())
         return true;
     else if (class1.getUC() == class2.getUC())
@@ -1223,7 +1614,7 @@ bool Terminal::classesByUcCode(Class class1, Class class2) {
     return false;
 }
 
-bool Terminal::classesByOccupation(Class class1, Class class2) {
+bool Terminal::classesByOccupation(const Class &class1, const Class &class2) {
     if (class1.getOccupation() < class2.getOccupation())
         return true;
     else  if (class1.getOccupation() == class2.getOccupation())
@@ -1231,7 +1622,7 @@ bool Terminal::classesByOccupation(Class class1, Class class2) {
     return false;
 }
 
-bool Terminal::ucsByYear(UC uc1, UC uc2) {
+bool Terminal::ucsByYear(const UC &uc1, const UC &uc2) {
     if (uc1.getYear() < uc2.getYear())
         return true;
     else if (uc1.getYear() == uc2.getYear())
@@ -1239,7 +1630,7 @@ bool Terminal::ucsByYear(UC uc1, UC uc2) {
     return false;
 }
 
-bool Terminal::ucsByOccupation(UC uc1, UC uc2) {
+bool Terminal::ucsByOccupation(const UC &uc1, const UC &uc2) {
     if (uc1.getOccupation() < uc2.getOccupation())
         return true;
     else if (uc1.getOccupation() == uc2.getOccupation())
@@ -1247,7 +1638,7 @@ bool Terminal::ucsByOccupation(UC uc1, UC uc2) {
     return false;
 }
 
-bool Terminal::yearsByYear(std::pair<std::string, int> pair1, std::pair<std::string, int> pair2) {
+bool Terminal::yearsByYear(const std::pair<std::string, int> &pair1, const std::pair<std::string, int> &pair2) {
     if (pair1.first < pair2.first)
         return true;
     else if (pair1.first == pair2.first)
@@ -1255,7 +1646,7 @@ bool Terminal::yearsByYear(std::pair<std::string, int> pair1, std::pair<std::str
     return false;
 }
 
-bool Terminal::yearsByOccupation(std::pair<std::string, int> pair1, std::pair<std::string, int> pair2) {
+bool Terminal::yearsByOccupation(const std::pair<std::string, int> &pair1, const std::pair<std::string, int> &pair2) {
     if (pair1.second < pair2.second)
         return true;
     else if (pair1.second < pair2.second)
@@ -6,7 +6,15 @@
 #include <vector>
 #include <stack>
 #include <queue>
+#include <map>
+#include <functional>
+#include <memory>
 #include "Course.h"
+#include "Waitlist.h"
+#include "History.h"
+#include "DataWatcher.h"
+#include "ScheduleLayout.h"
+#include "Screen.h"
 
 
 
@@ -43,6 +51,14 @@ struct occupationOptions {
         return !(years || UCs || classes);
     }
 
+    /**
+     * Checks if the balance column is displayed, it only makes sense when each row is a UC
+     * @return true if the UC's are displayed and the classes aren't
+     */
+    bool displayBalance() const {
+        return UCs && !classes;
+    }
+
     /**
      * Gets what is the real column to order by is.
      * @param orderBy Column number, of the column currently being displayed, to order by
@@ -94,21 +110,54 @@ private:
      * @brief Queue with the requests made before the Terminal started running
      */
     std::queue<Request*> pastRequests;
+    /**
+     * @brief Requests rejected because a class was full, waiting for a seat
+     */
+    Waitlist waitlist;
+    /**
+     * @brief Requests done, to consult the Course as it was after any of them
+     */
+    History history;
+    /**
+     * @brief Course as it was after a past request, consulted instead of the present one while it is set
+     */
+    std::unique_ptr<Course> pastCourse;
+    /**
+     * @brief Number of requests done in pastCourse
+     */
+    size_t pastCourseRequests;
+    /**
+     * @brief Layouts of the class and UC schedules printed, with the timetable version of the Course they were built from
+     */
+    std::map<std::string, std::pair<unsigned long, ScheduleLayout>> layoutCache;
+    /**
+     * @brief Applies the changes of the data files to the course, checked every time the main menu is printed
+     */
+    DataWatcher watcher;
+    /**
+     * @brief Output of the Terminal, each screen is built in memory and written at once
+     */
+    Screen screen;
     const static int MENU_WIDTH = 60;
     const static int SCHEDULE_COL_WIDTH = 20;
     const static int SCHEDULE_LINE_HEIGHT = 1;
     const static int STUDENT_CODE_COL_WIDTH = 11;
     const static int STUDENT_NAME_COL_WIDTH = 15;
     const static int OVERLAPPED_COL_WIDTH = 15;
+    const static int AVAILABILITY_COL_WIDTH = 15;
 
 
 public:
-    Terminal(const Course &course);
+    Terminal(Course &&course);
     ~Terminal();
     void run();
+    static void writeSchedule(std::ostream &os, const ScheduleLayout &layout);
 
 private:
     void redoPastRequests();
+    const Course& consulted() const;
+    void consultPast(const std::string &point);
+    void reloadData();
 
     // Wait for inputs
     void waitMenu();
@@ -127,28 +176,36 @@ private:
     void printUndo();
     void printUndoMenu();
     void printExit();
+    void printStatistics();
+    void printPastCourse();
+    void groupAvailabilityMenu();
 
     // Assess requests
     void assessRequest(Request *request);
 
     void undoLastRequest();
+    void processRequestFile(const std::string &path);
+    void promoteWaitlist();
 
     // Print schedules
     void printUcSchedule(std::string& ucCode);
     void printClassSchedule(std::string& classCode);
     void printStudentSchedule(std::string& studentCode);
 
-    void printSchedule(const Schedule& schedule);
-    void printOverlappedLectures(const std::set<Lecture>& lectures);
+    void printSchedule(const ScheduleLayout &layout);
+    const ScheduleLayout& getScheduleLayout(const std::string &key, const std::function<Schedule()> &getSchedule);
+    static void writeOverlappedLectures(std::ostream &os, const std::set<Lecture>& lectures);
+    void printGroupAvailability(const std::vector<Student*> &students, const std::string &message);
+    void printInSession(const std::string &weekday, float hour);
 
     // Auxiliar formatting functions
-    std::string formatUcAndType(const std::string& ucCode, const std::string& type);
-    std::string formatHour(float hour);
-    std::string formatHourRange(float startHour, float endHour);
-    std::string formatWeekday(int weekday);
-    std::string fill(char c, int width);
-    std::string center(const std::string &str, char sep, int width);
-    int getMiddleOfLectureBox(float duration);
+    static std::string formatUcAndType(const std::string& ucCode, const std::string& type);
+    static std::string formatHour(float hour);
+    static std::string formatHourRange(float startHour, float endHour);
+    static std::string formatWeekday(int weekday);
+    static std::string fill(char c, int width);
+    static std::string center(const std::string &str, char sep, int width);
+    static int getMiddleOfLectureBox(float duration);
 
 
     // Print students
@@ -185,18 +242,18 @@ private:
     bool static byStudentName(Student *student1, Student *student2);
     bool static byStudentCode(Student *student1, Student *student2);
     // Sort lectures
-    bool static byWeekday(Lecture lecture1, Lecture lecture2);
+    bool static byWeekday(const Lecture &lecture1, const Lecture &lecture2);
 
 
-    bool static classesByYear(Class class1, Class class2);
-    bool static classesByUcCode(Class class1, Class class2);
-    bool static classesByOccupation(Class class1, Class class2);
+    bool static classesByYear(const Class &class1, const Class &class2);
+    bool static classesByUcCode(const Class &class1, const Class &class2);
+    bool static classesByOccupation(const Class &class1, const Class &class2);
 
-    bool static ucsByYear(UC uc1, UC uc2);
-    bool static ucsByOccupation(UC uc1, UC uc2);
+    bool static ucsByYear(const UC &uc1, const UC &uc2);
+    bool static ucsByOccupation(const UC &uc1, const UC &uc2);
 
-    bool static yearsByYear(std::pair<std::string, int> pair1, std::pair<std::string, int> pair2);
-    bool static yearsByOccupation(std::pair<std::string, int> pair1, std::pair<std::string, int> pair2);
+    bool static yearsByYear(const std::pair<std::string, int> &pair1, const std::pair<std::string, int> &pair2);
+    bool static yearsByOccupation(const std::pair<std::string, int> &pair1, const std::pair<std::string, int> &pair2);
 };
 
 
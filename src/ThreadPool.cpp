@@ -0,0 +1,50 @@
+#include "ThreadPool.h"
+
+/**
+ * @brief Constructor of ThreadPool, starts the threads
+ * @param threads number of threads, at least 1
+ */
+ThreadPool::ThreadPool(size_t threads) : stopping(false) {
+    if (threads == 0)
+        threads = 1;
+    for (size_t i = 0; i < threads; i++)
+        workers.emplace_back(&ThreadPool::work, this);
+}
+
+/**
+ * @brief Destructor of ThreadPool, waits for the tasks queued and for the threads to finish
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+/**
+ * @brief Gets the number of threads
+ */
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+/**
+ * @brief Loop of each thread: takes the first task queued and runs it, until the pool stops and no task is left
+ */
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef PROJETO_THREADPOOL_H
+#define PROJETO_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief ThreadPool runs tasks on a fixed number of threads, in the order they were submitted
+ * @note The tasks still queued when the pool is destroyed are run before its threads finish
+ */
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void work();
+
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool &pool) = delete;
+    ThreadPool& operator=(const ThreadPool &pool) = delete;
+    ~ThreadPool();
+    size_t size() const;
+
+    /**
+     * @brief Queues a task to run on one of the threads
+     * @param task callable without arguments
+     * @return future with the result of the task (or the exception it threw)
+     */
+    template<typename Task>
+    auto submit(Task task) -> std::future<decltype(task())> {
+        auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(std::move(task));
+        std::future<decltype(task())> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        available.notify_one();
+        return result;
+    }
+};
+
+
+#endif //PROJETO_THREADPOOL_H
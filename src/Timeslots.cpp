@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cmath>
+#include "Timeslots.h"
+
+/**
+ * @brief Gets the slot of the half hour that contains an hour of a weekday
+ * @param weekday
+ * @param hour
+ * @return slot, the first or the last slot of the day if the hour is outside the schedule
+ */
+int Timeslots::getSlot(int weekday, float hour) {
+    int slotOfDay = (int) std::floor((hour - FIRST_HOUR) * 2);
+    return weekday * SLOTS_PER_DAY + std::clamp(slotOfDay, 0, SLOTS_PER_DAY - 1);
+}
+
+/**
+ * @brief Gets the number of a weekday of the schedule from its name, e.g. "Monday" or "monday" is 0
+ * @param weekday
+ * @return number of the weekday, -1 if it isn't a weekday of the schedule
+ */
+int Timeslots::parseWeekday(std::string weekday) {
+    std::transform(weekday.begin(), weekday.end(), weekday.begin(), ::tolower);
+    for (int day = 0; day < DAYS; day++) {
+        std::string name = getWeekdayName(day);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name == weekday)
+            return day;
+    }
+    return -1;
+}
+
+/**
+ * @brief Gets the name of a weekday of the schedule
+ * @param weekday number of the weekday, 0 is Monday
+ * @return name, e.g. "Monday"
+ */
+const std::string& Timeslots::getWeekdayName(int weekday) {
+    static const std::string names[DAYS] = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+    return names[weekday];
+}
+
+/**
+ * @brief Gets the weekday of a slot
+ * @param slot
+ */
+int Timeslots::getWeekday(int slot) {
+    return slot / SLOTS_PER_DAY;
+}
+
+/**
+ * @brief Gets the hour a slot starts
+ * @param slot
+ */
+float Timeslots::getHour(int slot) {
+    return FIRST_HOUR + (float) (slot % SLOTS_PER_DAY) / 2;
+}
+
+/**
+ * @brief Gets the slots a Lecture takes, every half hour it is occurring at least partly
+ * @param lecture
+ * @return slots, none if the Lecture isn't on a weekday of the schedule
+ * @details Time Complexity O(d) d = number of half hours of the lecture
+ */
+Timeslots::Mask Timeslots::getLectureSlots(const Lecture &lecture) {
+    Mask slots;
+    if (lecture.getWeekday() < 0 || lecture.getWeekday() >= DAYS)
+        return slots;
+    int first = std::max(0, (int) std::floor((lecture.getStartHour() - FIRST_HOUR) * 2));
+    int last = std::min(SLOTS_PER_DAY, (int) std::ceil((lecture.getEndHour() - FIRST_HOUR) * 2));
+    for (int slotOfDay = first; slotOfDay < last; slotOfDay++)
+        slots.set(lecture.getWeekday() * SLOTS_PER_DAY + slotOfDay);
+    return slots;
+}
@@ -0,0 +1,35 @@
+#ifndef PROJETO_TIMESLOTS_H
+#define PROJETO_TIMESLOTS_H
+
+#include <bitset>
+#include <string>
+#include "Lecture.h"
+
+/**
+ * @brief Timeslots divides the week (Monday to Saturday, 08:00 to 22:00, like the schedule tables) into half-hour slots,
+ * so that a set of slots fits in a bitset and sets of slots are combined a machine word at a time.
+ * @note Slot s is the half hour starting at FIRST_HOUR + (s % SLOTS_PER_DAY) / 2 of the weekday s / SLOTS_PER_DAY
+ */
+
+class Timeslots {
+public:
+    static constexpr int DAYS = 6;
+    static constexpr int FIRST_HOUR = 8;
+    static constexpr int LAST_HOUR = 22;
+    static constexpr int SLOTS_PER_DAY = (LAST_HOUR - FIRST_HOUR) * 2;
+    static constexpr int SLOTS = DAYS * SLOTS_PER_DAY;
+    /**
+     * Set of slots of the week
+     */
+    using Mask = std::bitset<SLOTS>;
+
+    static int getSlot(int weekday, float hour);
+    static int parseWeekday(std::string weekday);
+    static const std::string& getWeekdayName(int weekday);
+    static int getWeekday(int slot);
+    static float getHour(int slot);
+    static Mask getLectureSlots(const Lecture &lecture);
+};
+
+
+#endif //PROJETO_TIMESLOTS_H
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <climits>
+#include <vector>
 #include "UC.h"
 
 /**
@@ -5,7 +8,7 @@
  * @param ucCode code of the UC that is being created
  */
 
-UC::UC(std::string ucCode) : ucCode(ucCode) {}
+UC::UC(std::string ucCode) : ucCode(std::move(ucCode)), minOccupation(0), maxOccupation(0) {}
 
 /**
  * @brief Adds a Class to the UC
@@ -13,24 +16,65 @@ UC::UC(std::string ucCode) : ucCode(ucCode) {}
  * @details Time Complexity O(log n) n = number of classesEnrolled
  */
 void UC::addClass(Class class_) {
-    classesEnrolled.insert(class_);
+    int occupation = class_.getOccupation();
+    auto inserted = classesEnrolled.insert(std::move(class_));
+    if (inserted.second)
+        updateOccupation(inserted.first->getClassCode(), -1, occupation);
+}
+
+/**
+ * @brief Moves a Class to the bucket of its new occupation in classesByOccupation, and updates the count of Classes
+ * with each occupation and the least and greatest occupations
+ * @param classCode
+ * @param previous occupation before the change, -1 if the Class wasn't in the UC
+ * @param current occupation after the change, -1 if the Class was removed from the UC
+ * @details Time Complexity O(log n) n = size of classesEnrolled
+ */
+void UC::updateOccupation(const std::string &classCode, int previous, int current) {
+    if (previous == current)
+        return;
+    if (previous >= 0) {
+        auto bucket = classesByOccupation.find(previous);
+        bucket->second.erase(classCode);
+        if (bucket->second.empty())
+            classesByOccupation.erase(bucket);
+        occupationCounts[previous]--;
+    }
+    if (current >= 0) {
+        classesByOccupation[current].insert(classCode);
+        if (current >= (int) occupationCounts.size())
+            occupationCounts.resize(current + 1, 0);
+        occupationCounts[current]++;
+    }
+    minOccupation = classesByOccupation.empty() ? 0 : classesByOccupation.begin()->first;
+    maxOccupation = classesByOccupation.empty() ? 0 : classesByOccupation.rbegin()->first;
+}
+
+/**
+ * @brief Gets the number of Classes of the UC with an occupation
+ * @param occupation
+ * @return count, 0 for an occupation no Class has
+ * @details Time Complexity O(1)
+ */
+int UC::countClassesWith(int occupation) const {
+    return occupation >= 0 && occupation < (int) occupationCounts.size() ? occupationCounts[occupation] : 0;
 }
 
 /**
  * @brief Adds a student to the UC, through adding him to a Class of the UC
  * @param student
  * @param classCode code of the Class which the student is being added
- * @details Time Complexity O(n) n = number of classesEnrolled
- */
-void UC::addStudent(Student* student,std::string classCode) {
-    for (Class class_ : classesEnrolled) {
-        if (class_.getClassCode() == classCode) {
-           classesEnrolled.erase(class_);
-           class_.addStudent(student);
-           classesEnrolled.insert(class_);
-           return;
-        }
-    }
+ * @note The Class is taken out of the set and put back without being copied
+ * @details Time Complexity O(log n) n = number of classesEnrolled
+ */
+void UC::addStudent(Student* student, const std::string &classCode) {
+    auto node = classesEnrolled.extract(Class(classCode, ucCode));
+    if (node.empty())
+        return;
+    int previous = node.value().getOccupation();
+    node.value().addStudent(student);
+    updateOccupation(classCode, previous, node.value().getOccupation());
+    classesEnrolled.insert(std::move(node));
 }
 
 /**
@@ -40,7 +84,7 @@ void UC::addStudent(Student* student,std::string classCode) {
  */
 std::set<Student*, cmp> UC::getStudents() const {
     std::set<Student*, cmp> studentsInUc;
-    for (Class class_ : classesEnrolled) {
+    for (const Class &class_ : classesEnrolled) {
         for (Student* student : class_.getStudents()) {
             studentsInUc.insert(student);
         }
@@ -52,10 +96,90 @@ std::set<Student*, cmp> UC::getStudents() const {
  * @brief Get the Classes registered in the UC
  * @return classesEnrolled
  */
-std::set<Class> UC::getClasses() const {
+const std::set<Class>& UC::getClasses() const {
     return classesEnrolled;
 }
 
+/**
+ * @brief Points the Classes of the UC to copies of their Students, e.g. the ones of a copy of the Course. The Classes
+ * keep their address.
+ * @param copies copy of each Student
+ * @details Time Complexity O(n) n = number of students in the Classes of the UC
+ */
+void UC::relinkStudents(const std::unordered_map<const Student*, Student*> &copies) {
+    for (auto class_ = classesEnrolled.begin(); class_ != classesEnrolled.end();) {
+        auto next = std::next(class_);
+        auto node = classesEnrolled.extract(class_);
+        node.value().relinkStudents(copies);
+        classesEnrolled.insert(next, std::move(node));
+        class_ = next;
+    }
+}
+
+/**
+ * @brief Gets the codes of the Classes of the UC grouped by occupation, least occupied first
+ * @return classesByOccupation
+ */
+const std::map<int, std::set<std::string>>& UC::getClassesByOccupation() const {
+    return classesByOccupation;
+}
+
+/**
+ * @brief Gets the occupation of the least occupied Class of the UC
+ * @return minimum occupation, 0 if the UC has no classes
+ * @details Time Complexity O(1)
+ */
+int UC::getMinOccupation() const {
+    return minOccupation;
+}
+
+/**
+ * @brief Gets the occupation of the most occupied Class of the UC
+ * @return maximum occupation, 0 if the UC has no classes
+ * @details Time Complexity O(1)
+ */
+int UC::getMaxOccupation() const {
+    return maxOccupation;
+}
+
+/**
+ * @brief Gets the difference between the occupation of the most and the least occupied Classes of the UC
+ * @details Time Complexity O(1)
+ */
+int UC::getOccupationSpread() const {
+    return getMaxOccupation() - getMinOccupation();
+}
+
+/**
+ * @brief Gets the spread the UC would have if a Student moved from a Class with occupation from to a different Class
+ * with occupation to, without changing the UC
+ * @param from occupation of the Class the Student leaves
+ * @param to occupation of the Class the Student joins
+ * @return spread after the move
+ * @note Only the occupations from and to lose a Class, and from - 1 and to + 1 gain one. If the least (or greatest)
+ * occupation loses its last Class, one of the two that gain one takes its place, since every other Class is at least
+ * (or at most) as occupied as them, so the new minimum and maximum are among those three occupations.
+ * @details Time Complexity O(1)
+ */
+int UC::getOccupationSpreadAfterMove(int from, int to) const {
+    if (classesByOccupation.empty())
+        return 0;
+    auto countAfter = [&](int occupation) {
+        return countClassesWith(occupation) + (occupation == from - 1) + (occupation == to + 1) - (occupation == from)
+               - (occupation == to);
+    };
+    const int gained[2] = {from - 1, to + 1};
+    int newMin = countAfter(minOccupation) > 0 ? minOccupation : INT_MAX;
+    int newMax = countAfter(maxOccupation) > 0 ? maxOccupation : INT_MIN;
+    for (int occupation : gained) {
+        if (occupation >= 0) {
+            newMin = std::min(newMin, occupation);
+            newMax = std::max(newMax, occupation);
+        }
+    }
+    return newMax - newMin;
+}
+
 /**
  * @brief Compares UC's through its ucCode
  * @param uc
@@ -68,7 +192,7 @@ bool UC::operator<(const UC &uc) const {
  * @brief Get the ucCode of the UC
  * @return ucCode
  */
-std::string UC::getUcCode() const {
+const std::string& UC::getUcCode() const {
     return ucCode;
 }
 
@@ -80,23 +204,34 @@ std::string UC::getUcCode() const {
  * @param weekday
  * @param startHour
  * @param duration
- * @details Time Complexity O(n) n = size of classesEnrolled
+ * @details Time Complexity O(log n) n = size of classesEnrolled
  */
-void UC::addLecture(std::string classCode, std::string ucCode, std::string type, std::string weekday, float startHour,float duration) {
-  for(Class class_:classesEnrolled){
-    if(class_.getClassCode()==classCode){
-      classesEnrolled.erase(class_);
-      class_.addLecture(classCode,ucCode,weekday,startHour,duration,type);
-      classesEnrolled.insert(class_);
-      return;
-    }
-  }
+void UC::addLecture(const std::string &classCode, std::string ucCode, std::string type, const std::string &weekday, float startHour,float duration) {
+    auto node = classesEnrolled.extract(Class(classCode, this->ucCode));
+    if (node.empty())
+        return;
+    node.value().addLecture(classCode,std::move(ucCode),weekday,startHour,duration,std::move(type));
+    classesEnrolled.insert(std::move(node));
+}
+
+/**
+ * @brief Removes a lecture from a certain Class of the UC
+ * @param classCode code of the class the Lecture is removed from
+ * @param lecture
+ * @details Time Complexity O(log n) n = size of classesEnrolled
+ */
+void UC::removeLecture(const std::string &classCode, const Lecture &lecture) {
+    auto node = classesEnrolled.extract(Class(classCode, ucCode));
+    if (node.empty())
+        return;
+    node.value().removeLecture(lecture);
+    classesEnrolled.insert(std::move(node));
 }
 
 /**
  * @brief Gets the year of the UC
  */
-std::string UC::getYear() const{
+const std::string& UC::getYear() const{
     return (*classesEnrolled.begin()).getYear();
 }
 
@@ -107,7 +242,7 @@ std::string UC::getYear() const{
  */
 Schedule UC::getSchedule()const {
     Schedule ucSchedule;
-    for (Class class_ : classesEnrolled) {
+    for (const Class &class_ : classesEnrolled) {
         ucSchedule += class_.getSchedule();
     }
     return ucSchedule;
@@ -131,25 +266,48 @@ int UC::getOccupation() const {
  * @param class_ Class which is going to be removed
  * @details Time Complexity O(log n) n = size of classesEnrolled
  */
-void UC::removeClass(Class class_) {
-    classesEnrolled.erase(class_);
+void UC::removeClass(const Class &class_) {
+    auto enrolled = classesEnrolled.find(class_);
+    if (enrolled == classesEnrolled.end())
+        return;
+    updateOccupation(enrolled->getClassCode(), enrolled->getOccupation(), -1);
+    classesEnrolled.erase(enrolled);
 }
 
 /**
  * @brief Removes a Student from the UC
  * @param student Student which is going to be removed
+ * @return code of the Class the Student left, empty if the Student wasn't in the UC
  * @details Time Complexity O(n log m) n = size of classesEnrolled, m= number of students of a class
  */
-void UC::removeStudent(Student *student) {
-    for (Class class_ : classesEnrolled) {
-        auto studentIt = class_.getStudents().find(student);
-        auto end = class_.getStudents().end();
-        if (studentIt != end) {
-            classesEnrolled.erase(class_);
-            class_.removeStudent(student);
-            classesEnrolled.insert(class_);
-            return;
+std::string UC::removeStudent(Student *student) {
+    for (auto class_ = classesEnrolled.begin(); class_ != classesEnrolled.end(); class_++) {
+        if (class_->getStudents().find(student) != class_->getStudents().end()) {
+            auto node = classesEnrolled.extract(class_);
+            int previous = node.value().getOccupation();
+            node.value().removeStudent(student);
+            updateOccupation(node.value().getClassCode(), previous, node.value().getOccupation());
+            std::string classCode = node.value().getClassCode();
+            classesEnrolled.insert(std::move(node));
+            return classCode;
         }
     }
+    return "";
+}
+
+/**
+ * @brief Removes a Student from a certain Class of the UC
+ * @param student Student which is going to be removed
+ * @param classCode code of the Class
+ * @details Time Complexity O(log n + k log m) n = size of classesEnrolled, k = number of lectures of the Class, m = number of lectures of the student
+ */
+void UC::removeStudent(Student *student, const std::string &classCode) {
+    auto node = classesEnrolled.extract(Class(classCode, ucCode));
+    if (node.empty())
+        return;
+    int previous = node.value().getOccupation();
+    node.value().removeStudent(student);
+    updateOccupation(classCode, previous, node.value().getOccupation());
+    classesEnrolled.insert(std::move(node));
 }
 
@@ -1,6 +1,8 @@
 #ifndef PROJETO_UC_H
 #define PROJETO_UC_H
 
+#include <map>
+#include <vector>
 #include "Student.h"
 #include "Class.h"
 
@@ -12,20 +14,46 @@ class UC {
 private:
     std::string ucCode;
     std::set<Class> classesEnrolled;
+    /**
+     * Codes of the classesEnrolled grouped by occupation, least occupied first. Kept up to date on every change of the
+     * classes or of their students. The size of each bucket is the occupation histogram used by the balance check.
+     */
+    std::map<int, std::set<std::string>> classesByOccupation;
+    /**
+     * Number of classesEnrolled with each occupation, by occupation, so that the balance check reads a count without a
+     * search
+     */
+    std::vector<int> occupationCounts;
+    /**
+     * Least and greatest occupation of the classesEnrolled, 0 if the UC has no classes
+     */
+    int minOccupation;
+    int maxOccupation;
+
+    int countClassesWith(int occupation) const;
+    void updateOccupation(const std::string &classCode, int previous, int current);
 
 public:
     UC(std::string ucCode);
-    std::string getUcCode() const;
+    const std::string& getUcCode() const;
     void addClass(Class class_);
-    void addStudent(Student* student, std::string classCode);
-    void addLecture(std::string classCode, std::string ucCode, std::string type, std::string weekday, float startHour, float duration);
+    void addStudent(Student* student, const std::string &classCode);
+    void addLecture(const std::string &classCode, std::string ucCode, std::string type, const std::string &weekday, float startHour, float duration);
+    void removeLecture(const std::string &classCode, const Lecture &lecture);
     std::set<Student*, cmp> getStudents() const;
-    std::set<Class> getClasses() const;
-    std::string getYear() const;
+    const std::set<Class>& getClasses() const;
+    void relinkStudents(const std::unordered_map<const Student*, Student*> &copies);
+    const std::map<int, std::set<std::string>>& getClassesByOccupation() const;
+    int getMinOccupation() const;
+    int getMaxOccupation() const;
+    int getOccupationSpread() const;
+    int getOccupationSpreadAfterMove(int from, int to) const;
+    const std::string& getYear() const;
     Schedule getSchedule() const;
     int getOccupation() const;
-    void removeClass(Class class_);
-    void removeStudent(Student *student);
+    void removeClass(const Class &class_);
+    std::string removeStudent(Student *student);
+    void removeStudent(Student *student, const std::string &classCode);
     bool operator<(const UC& uc) const;
 };
 
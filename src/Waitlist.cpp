@@ -0,0 +1,144 @@
+#include "Waitlist.h"
+
+/**
+ * @brief Constructor of an empty Waitlist
+ * @param capacity maximum number of requests of each queue
+ */
+Waitlist::Waitlist(size_t capacity) : capacity(capacity) {}
+
+/**
+ * @brief Destructor of the Waitlist, frees the requests still waiting
+ */
+Waitlist::~Waitlist() {
+    for (auto &[key, queue] : classQueues) {
+        for (Request *request : queue)
+            delete request;
+    }
+    for (auto &[key, queue] : ucQueues) {
+        for (Request *request : queue)
+            delete request;
+    }
+}
+
+/**
+ * @brief Key of the queue of a Class
+ * @param ucCode
+ * @param classCode
+ */
+std::string Waitlist::classKey(const std::string &ucCode, const std::string &classCode) {
+    return ucCode + "," + classCode;
+}
+
+/**
+ * @brief Gets the queue where a request waits: the queue of the Class it needs or of the UC it wants to join
+ * @param request
+ * @return queue, nullptr for the requests that don't take a seat (leaves)
+ */
+std::deque<Request*>* Waitlist::queueOf(const Request *request) {
+    if (const JoinRequest *joinReq = dynamic_cast<const JoinRequest*>(request)) {
+        if (!joinReq->getClassCode().empty())
+            return &classQueues[classKey(joinReq->getUcCode(), joinReq->getClassCode())];
+        return &ucQueues[joinReq->getUcCode()];
+    }
+    if (const SwitchUcRequest *switchUcReq = dynamic_cast<const SwitchUcRequest*>(request))
+        return &ucQueues[switchUcReq->getUcCodeNext()];
+    if (const SwitchClassRequest *switchClassReq = dynamic_cast<const SwitchClassRequest*>(request))
+        return &classQueues[classKey(switchClassReq->getUcCode(), switchClassReq->getClassCodeNext())];
+    return nullptr;
+}
+
+/**
+ * @brief Checks if a rejected request can wait for a seat, i.e. it was rejected only because a Class was full
+ * @param request
+ */
+bool Waitlist::canWait(const Request *request) {
+    return request->getRejection() == Request::CLASS_FULL && dynamic_cast<const LeaveRequest*>(request) == nullptr;
+}
+
+/**
+ * @brief Puts a request at the end of its queue, the Waitlist takes ownership of it
+ * @param request
+ * @return position in the queue (starting at 1), 0 if the queue is full and the request wasn't added
+ * @details Time Complexity O(1)
+ */
+size_t Waitlist::add(Request *request) {
+    std::deque<Request*> *queue = queueOf(request);
+    if (queue == nullptr || queue->size() >= capacity)
+        return 0;
+    queue->push_back(request);
+    return queue->size();
+}
+
+/**
+ * @brief Gives the seats freed in the Course since the last call to the requests waiting for them. For each seat, the
+ * first request waiting for that Class, or else for its UC, is assessed again: if accepted it may free another seat
+ * (e.g. a class switch), which is handled the same way; if the Class is full again it keeps its place; otherwise it
+ * can't be done anymore and is discarded, and the next request of that queue is assessed for the seat.
+ * @param course
+ * @return requests accepted, in the order they were done. The caller takes ownership of them.
+ * @details Time Complexity O((s + d) * assessRequest) s = number of seats freed, d = number of requests discarded
+ */
+std::vector<Request*> Waitlist::promote(Course &course) {
+    std::vector<Request*> promoted;
+    std::deque<std::pair<std::string, std::string>> seats;
+    for (auto &seat : course.takeFreedSeats())
+        seats.push_back(std::move(seat));
+    while (!seats.empty()) {
+        auto [ucCode, classCode] = std::move(seats.front());
+        seats.pop_front();
+        auto classQueue = classQueues.find(classKey(ucCode, classCode));
+        std::deque<Request*> *queue = nullptr;
+        if (classQueue != classQueues.end() && !classQueue->second.empty())
+            queue = &classQueue->second;
+        else {
+            auto ucQueue = ucQueues.find(ucCode);
+            if (ucQueue != ucQueues.end() && !ucQueue->second.empty())
+                queue = &ucQueue->second;
+        }
+        if (queue == nullptr)
+            continue;
+
+        // The requests that can't be done anymore don't use the seat, the next one in the queue is offered it
+        while (!queue->empty()) {
+            Request *request = queue->front();
+            queue->pop_front();
+            if (course.assessRequest(request)) {
+                promoted.push_back(request);
+                for (auto &seat : course.takeFreedSeats())
+                    seats.push_back(std::move(seat));
+                break;
+            }
+            if (request->getRejection() == Request::CLASS_FULL) {
+                queue->push_front(request);
+                break;
+            }
+            delete request;
+        }
+    }
+    return promoted;
+}
+
+/**
+ * @brief Gets every request waiting, each queue in order, e.g. to save them
+ */
+std::vector<Request*> Waitlist::getRequests() const {
+    std::vector<Request*> requests;
+    for (const auto &[key, queue] : classQueues)
+        requests.insert(requests.end(), queue.begin(), queue.end());
+    for (const auto &[key, queue] : ucQueues)
+        requests.insert(requests.end(), queue.begin(), queue.end());
+    return requests;
+}
+
+/**
+ * @brief Gets the number of requests waiting
+ * @details Time Complexity O(n) n = number of queues
+ */
+size_t Waitlist::size() const {
+    size_t total = 0;
+    for (const auto &[key, queue] : classQueues)
+        total += queue.size();
+    for (const auto &[key, queue] : ucQueues)
+        total += queue.size();
+    return total;
+}
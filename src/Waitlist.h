@@ -0,0 +1,40 @@
+#ifndef PROJETO_WAITLIST_H
+#define PROJETO_WAITLIST_H
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include "Course.h"
+
+/**
+ * @brief Waitlist keeps the requests rejected because a Class was full until a seat is freed. Each Class has a FIFO
+ * queue of the requests that need that Class (class switches, joins that name the Class) and each UC has a queue of
+ * the requests that can take any of its Classes (joins, UC switches). Queues are bounded.
+ * @note The Waitlist owns the requests it keeps
+ */
+
+class Waitlist {
+private:
+    size_t capacity;
+    std::unordered_map<std::string, std::deque<Request*>> classQueues;
+    std::unordered_map<std::string, std::deque<Request*>> ucQueues;
+
+    std::deque<Request*>* queueOf(const Request *request);
+    static std::string classKey(const std::string &ucCode, const std::string &classCode);
+
+public:
+    static const size_t DEFAULT_CAPACITY = 20;
+
+    explicit Waitlist(size_t capacity = DEFAULT_CAPACITY);
+    Waitlist(const Waitlist &waitlist) = delete;
+    Waitlist& operator=(const Waitlist &waitlist) = delete;
+    ~Waitlist();
+    static bool canWait(const Request *request);
+    size_t add(Request *request);
+    std::vector<Request*> promote(Course &course);
+    std::vector<Request*> getRequests() const;
+    size_t size() const;
+};
+
+
+#endif //PROJETO_WAITLIST_H
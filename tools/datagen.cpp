@@ -0,0 +1,291 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <bitset>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Options of the generated dataset
+ */
+struct GeneratorOptions {
+    int years = 3;
+    int ucsPerYear = 8;
+    int classesPerUc = 16;
+    /**
+     * Lectures of each class in each UC, the first one is the theoretical (T) lecture shared by the classes of the UC
+     */
+    int lecturesPerClass = 2;
+    int students = 800;
+    /**
+     * Average number of UC's each student is registered in, approximately: the number of each student is drawn around
+     * it and clamped to 1-7
+     */
+    int ucsPerStudent = 5;
+    int requests = 1000;
+    unsigned long seed = 1;
+    std::string outDir = "./";
+};
+
+/**
+ * @brief Lecture of a UC, before being assigned to a class
+ */
+struct GeneratedLecture {
+    std::string weekday;
+    float startHour;
+    float duration;
+    std::string type;
+};
+
+/**
+ * @brief Registration of a generated student in a class of a UC
+ */
+struct GeneratedEnrollment {
+    int uc;
+    int classNumber;
+};
+
+static const std::vector<std::string> WEEKDAYS = {"Monday", "Tuesday", "Wednesday", "Thursday", "Friday"};
+static const std::vector<std::string> NAMES = {"Iara", "Gisela", "Alexandre", "Carlota", "Diogo", "Beatriz", "Rui",
+                                                "Mariana", "Tiago", "Ines", "Joao", "Leonor", "Pedro", "Sofia",
+                                                "Miguel", "Rita", "Andre", "Catarina", "Bruno", "Helena"};
+
+/**
+ * @brief Code of a UC, ordered by year
+ * @param uc index of the UC
+ */
+static std::string ucCode(int uc) {
+    std::ostringstream oss;
+    oss << "L.EIC" << std::setfill('0') << std::setw(3) << uc + 1;
+    return oss.str();
+}
+
+/**
+ * @brief Code of a class, the classes of a year are shared by all its UC's (1LEIC01, 1LEIC02, ...)
+ * @param year starting at 1
+ * @param classNumber starting at 0
+ */
+static std::string classCode(int year, int classNumber) {
+    std::ostringstream oss;
+    oss << year << "LEIC" << std::setfill('0') << std::setw(2) << classNumber + 1;
+    return oss.str();
+}
+
+/**
+ * @brief Picks an index with probability proportional to its weight. Uses the numbers of the engine directly, unlike
+ * std::discrete_distribution, so that a seed generates the same files with any standard library.
+ * @param rng
+ * @param weights
+ */
+static int pickWeighted(std::mt19937_64 &rng, const std::vector<int> &weights) {
+    int total = 0;
+    for (int weight : weights)
+        total += weight;
+    int pick = rng() % total;
+    int index = 0;
+    while (pick >= weights[index])
+        pick -= weights[index++];
+    return index;
+}
+
+/**
+ * @brief Counts the heads in a number of fair coin flips, i.e. a binomial(flips, 0.5) number, with the bits of the
+ * engine, unlike std::binomial_distribution, so that a seed generates the same files with any standard library
+ * @param rng
+ * @param flips
+ */
+static int countHeads(std::mt19937_64 &rng, int flips) {
+    int heads = 0;
+    for (int flip = 0; flip < flips; flip += 64) {
+        unsigned long long bits = rng();
+        if (flips - flip < 64)
+            bits &= (1ULL << (flips - flip)) - 1;
+        heads += std::bitset<64>(bits).count();
+    }
+    return heads;
+}
+
+/**
+ * @brief Generates a random lecture, most of them in the morning and lasting 1 to 2 hours
+ * @param rng
+ * @param type
+ */
+static GeneratedLecture randomLecture(std::mt19937_64 &rng, const std::string &type) {
+    float duration = 1 + 0.5f * pickWeighted(rng, {2, 3, 5});      // 1h, 1.5h, 2h
+    float startHour;
+    switch (pickWeighted(rng, {6, 3, 1})) {                         // morning, afternoon, evening
+        case 0: startHour = 8 + 0.5f * (rng() % 8); break;         // 08:00 - 11:30
+        case 1: startHour = 13 + 0.5f * (rng() % 8); break;        // 13:00 - 16:30
+        default: startHour = 17 + 0.5f * (rng() % 6); break;       // 17:00 - 19:30
+    }
+    return {WEEKDAYS[rng() % WEEKDAYS.size()], startHour, duration, type};
+}
+
+/**
+ * @brief Writes classes_per_uc.csv and classes.csv
+ * @param options
+ * @param rng
+ */
+static void writeClasses(const GeneratorOptions &options, std::mt19937_64 &rng) {
+    std::ofstream perUc(options.outDir + "classes_per_uc.csv");
+    std::ofstream classes(options.outDir + "classes.csv");
+    perUc << "UcCode,ClassCode\r\n";
+    classes << "ClassCode,UcCode,Weekday,StartHour,Duration,Type\r\n";
+
+    for (int uc = 0; uc < options.years * options.ucsPerYear; uc++) {
+        int year = uc / options.ucsPerYear + 1;
+        // Big UC's split the theoretical lectures in two groups
+        GeneratedLecture theoretical[2] = {randomLecture(rng, "T"), randomLecture(rng, "T")};
+        for (int c = 0; c < options.classesPerUc; c++) {
+            perUc << ucCode(uc) << "," << classCode(year, c) << "\r\n";
+            for (int l = 0; l < options.lecturesPerClass; l++) {
+                GeneratedLecture lecture = l == 0 ? theoretical[c * 2 / std::max(1, options.classesPerUc)]
+                                                  : randomLecture(rng, rng() % 6 == 0 ? "PL" : "TP");
+                classes << classCode(year, c) << "," << ucCode(uc) << "," << lecture.weekday << ","
+                        << lecture.startHour << "," << lecture.duration << "," << lecture.type << "\r\n";
+            }
+        }
+    }
+}
+
+/**
+ * @brief Picks the UC's and classes of a student. Students belong mostly to a single year and tend to stay in the same
+ * class number across the UC's of that year.
+ * @param options
+ * @param rng
+ */
+static std::vector<GeneratedEnrollment> randomEnrollments(const GeneratorOptions &options, std::mt19937_64 &rng) {
+    int totalUcs = options.years * options.ucsPerYear;
+    int n = std::min(totalUcs, std::max(1, std::min(7, countHeads(rng, 2 * options.ucsPerStudent))));
+    int year = rng() % options.years;
+    int homeClass = rng() % options.classesPerUc;
+
+    std::vector<GeneratedEnrollment> enrollments;
+    std::vector<bool> taken(totalUcs, false);
+    while ((int) enrollments.size() < n) {
+        // 80% of the UC's from the student's year, the rest from any year
+        int uc = rng() % 5 != 0 ? year * options.ucsPerYear + (int) (rng() % options.ucsPerYear) : (int) (rng() % totalUcs);
+        if (taken[uc])
+            continue;
+        taken[uc] = true;
+        int classNumber = rng() % 5 != 0 ? homeClass : (int) (rng() % options.classesPerUc);
+        enrollments.push_back({uc, classNumber});
+    }
+    return enrollments;
+}
+
+/**
+ * @brief Writes students_classes.csv and request_history.txt, the requests refer to existing students, UC's and classes
+ * @param options
+ * @param rng
+ */
+static void writeStudents(const GeneratorOptions &options, std::mt19937_64 &rng) {
+    std::ofstream students(options.outDir + "students_classes.csv");
+    students << "StudentCode,StudentName,UcCode,ClassCode\r\n";
+    std::vector<std::vector<GeneratedEnrollment>> enrollments;
+    for (int s = 0; s < options.students; s++) {
+        std::string code = std::to_string(201900000L + s);
+        std::string name = NAMES[rng() % NAMES.size()];
+        enrollments.push_back(randomEnrollments(options, rng));
+        for (const GeneratedEnrollment &e : enrollments.back()) {
+            int year = e.uc / options.ucsPerYear + 1;
+            students << code << "," << name << "," << ucCode(e.uc) << "," << classCode(year, e.classNumber) << "\r\n";
+        }
+    }
+
+    std::ofstream history(options.outDir + "request_history.txt");
+    int totalUcs = options.years * options.ucsPerYear;
+    for (int r = 0; r < options.requests && options.students > 0; r++) {
+        int s = rng() % options.students;
+        std::string code = std::to_string(201900000L + s);
+        const GeneratedEnrollment &current = enrollments[s][rng() % enrollments[s].size()];
+        int year = current.uc / options.ucsPerYear + 1;
+        int otherUc = rng() % totalUcs;
+        switch (pickWeighted(rng, {3, 1, 2, 4})) {                 // Join, Leave, SwitchUc, SwitchClass
+            case 0:
+                history << "Join," << code << "," << ucCode(otherUc) << "\n";
+                break;
+            case 1:
+                history << "Leave," << code << "," << ucCode(current.uc) << "\n";
+                break;
+            case 2:
+                history << "SwitchUc," << code << "," << ucCode(current.uc) << "," << ucCode(otherUc) << "\n";
+                break;
+            default:
+                history << "SwitchClass," << code << "," << ucCode(current.uc) << ","
+                        << classCode(year, current.classNumber) << ","
+                        << classCode(year, (int) (rng() % options.classesPerUc)) << "\n";
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Prints how to use the generator
+ */
+static void printUsage() {
+    GeneratorOptions defaults;
+    std::cout << "Usage: projeto_datagen [options]\n"
+              << "  --out DIR                directory where the files are written (default ./)\n"
+              << "  --years N                (default " << defaults.years << ")\n"
+              << "  --ucs-per-year N         (default " << defaults.ucsPerYear << ")\n"
+              << "  --classes-per-uc N       (default " << defaults.classesPerUc << ")\n"
+              << "  --lectures-per-class N   (default " << defaults.lecturesPerClass << ")\n"
+              << "  --students N             (default " << defaults.students << ")\n"
+              << "  --ucs-per-student N      approximate average, each student gets 1 to 7 (default "
+              << defaults.ucsPerStudent << ")\n"
+              << "  --requests N             requests in request_history.txt (default " << defaults.requests << ")\n"
+              << "  --seed N                 same seed and options generate the same files on any platform (default "
+              << defaults.seed << ")\n";
+}
+
+int main(int argc, char *argv[]) {
+    GeneratorOptions options;
+    for (int arg = 1; arg < argc; arg++) {
+        std::string option = argv[arg];
+        if (option == "--help" || arg + 1 >= argc) {
+            printUsage();
+            return option == "--help" ? 0 : 1;
+        }
+        std::string value = argv[++arg];
+        if (option == "--out")
+            options.outDir = value.back() == '/' ? value : value + "/";
+        else if (option == "--years")
+            options.years = std::stoi(value);
+        else if (option == "--ucs-per-year")
+            options.ucsPerYear = std::stoi(value);
+        else if (option == "--classes-per-uc")
+            options.classesPerUc = std::stoi(value);
+        else if (option == "--lectures-per-class")
+            options.lecturesPerClass = std::stoi(value);
+        else if (option == "--students")
+            options.students = std::stoi(value);
+        else if (option == "--ucs-per-student")
+            options.ucsPerStudent = std::stoi(value);
+        else if (option == "--requests")
+            options.requests = std::stoi(value);
+        else if (option == "--seed")
+            options.seed = std::stoul(value);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.years < 1 || options.years > 9 || options.ucsPerYear < 1 || options.classesPerUc < 1 ||
+        options.classesPerUc > 99 || options.lecturesPerClass < 1 || options.students < 0 || options.ucsPerStudent < 1) {
+        std::cout << "Invalid options: years must be 1-9, classes per UC 1-99 and the remaining counts positive.\n";
+        return 1;
+    }
+
+    std::filesystem::create_directories(options.outDir);
+    std::mt19937_64 rng(options.seed);
+    writeClasses(options, rng);
+    writeStudents(options, rng);
+    std::cout << "Generated " << options.years * options.ucsPerYear << " UC's, "
+              << options.years * options.classesPerUc << " classes, " << options.students << " students and "
+              << options.requests << " requests in " << options.outDir << "\n";
+    return 0;
+}
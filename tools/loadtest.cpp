@@ -0,0 +1,173 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Metrics.h"
+
+/**
+ * @brief Options of the load test
+ */
+struct LoadTestOptions {
+    std::string socketPath;
+    int clients = 4;
+    /**
+     * Commands sent by each client, going through the commands over and over
+     */
+    int commands = 1000;
+    std::string commandsPath;
+};
+
+/**
+ * @brief Commands sent when no file is given, consults that work with any dataset
+ */
+static const std::vector<std::string> DEFAULT_COMMANDS = {
+        "UCsInYear,1", "Occupation,ucs", "Occupation,years", "InSession,Monday,10.5", "StudentsInAtLeastUCs,7"
+};
+
+/**
+ * @brief Connects to the Unix domain socket of the server
+ * @param path
+ * @return socket, -1 if it couldn't connect
+ */
+static int connectTo(const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+        return -1;
+    std::strcpy(address.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (sockaddr*) &address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Sends commands one at a time, waiting for the answer of each one, and records how long each one took
+ * @param options
+ * @param commands
+ * @param first index of the first command sent, so that the clients don't send the same commands at the same time
+ * @param latencies latency of each command, in nanoseconds
+ * @param errors number of answers with an error, or commands that got no answer
+ */
+static void runClient(const LoadTestOptions &options, const std::vector<std::string> &commands, size_t first,
+                      LatencyHistogram &latencies, std::atomic<uint64_t> &errors) {
+    int fd = connectTo(options.socketPath);
+    if (fd < 0) {
+        errors += options.commands;
+        return;
+    }
+    std::string buffer;
+    char data[65536];
+    for (int i = 0; i < options.commands; i++) {
+        std::string command = commands[(first + i) % commands.size()] + "\n";
+        auto start = std::chrono::steady_clock::now();
+        bool answered = send(fd, command.data(), command.size(), MSG_NOSIGNAL) == (ssize_t) command.size();
+        size_t end;
+        while (answered && (end = buffer.find('\n')) == std::string::npos) {
+            ssize_t n = read(fd, data, sizeof(data));
+            if (n <= 0)
+                answered = false;
+            else
+                buffer.append(data, n);
+        }
+        if (!answered) {
+            errors += options.commands - i;
+            break;
+        }
+        latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        if (buffer.substr(0, end).find("\"status\":\"error\"") != std::string::npos)
+            errors++;
+        buffer.erase(0, end + 1);
+    }
+    close(fd);
+}
+
+static void printUsage() {
+    LoadTestOptions defaults;
+    std::cout << "Usage: projeto_loadtest SOCKET [options]\n"
+              << "  SOCKET                   socket of a server started with projeto --serve SOCKET\n"
+              << "  --clients N              connections sending commands at the same time (default " << defaults.clients << ")\n"
+              << "  --commands N             commands sent by each client (default " << defaults.commands << ")\n"
+              << "  --file PATH              commands to send, one per line, like projeto --exec (default: a few consults)\n";
+}
+
+int main(int argc, char *argv[]) {
+    LoadTestOptions options;
+    for (int arg = 1; arg < argc; arg++) {
+        std::string option = argv[arg];
+        if (option == "--help") {
+            printUsage();
+            return 0;
+        }
+        if (option.rfind("--", 0) != 0 && options.socketPath.empty()) {
+            options.socketPath = option;
+            continue;
+        }
+        if (arg + 1 >= argc) {
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++arg];
+        if (option == "--clients")
+            options.clients = std::stoi(value);
+        else if (option == "--commands")
+            options.commands = std::stoi(value);
+        else if (option == "--file")
+            options.commandsPath = value;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.socketPath.empty() || options.clients < 1 || options.commands < 1) {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<std::string> commands = DEFAULT_COMMANDS;
+    if (!options.commandsPath.empty()) {
+        std::ifstream file(options.commandsPath);
+        commands.clear();
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line[0] != '#')
+                commands.push_back(line);
+        }
+        if (commands.empty()) {
+            std::cout << "No commands in " << options.commandsPath << "\n";
+            return 1;
+        }
+    }
+
+    LatencyHistogram latencies;
+    std::atomic<uint64_t> errors(0);
+    std::vector<std::thread> clients;
+    auto start = std::chrono::steady_clock::now();
+    for (int client = 0; client < options.clients; client++) {
+        size_t first = commands.size() * client / options.clients;
+        clients.emplace_back(runClient, std::cref(options), std::cref(commands), first, std::ref(latencies), std::ref(errors));
+    }
+    for (std::thread &client : clients)
+        client.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << options.clients << " clients, " << latencies.getCount() << " commands answered in " << seconds << " s ("
+              << latencies.getCount() / seconds << " commands/s), " << errors.load() << " errors\n"
+              << "latency (us): mean " << latencies.getMean() / 1000
+              << ", p50 " << latencies.getPercentile(50) / 1000.0
+              << ", p90 " << latencies.getPercentile(90) / 1000.0
+              << ", p99 " << latencies.getPercentile(99) / 1000.0
+              << ", max " << latencies.getMax() / 1000.0 << "\n";
+    return errors.load() == 0 ? 0 : 1;
+}